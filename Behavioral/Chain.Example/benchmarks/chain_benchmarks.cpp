@@ -0,0 +1,185 @@
+#include "chain.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Previous implementation - linked list of shared_ptr nodes dispatched recursively
+    class LinkedDeviceHandler
+    {
+        std::function<bool(Temperature)> can_handle_;
+        std::function<void(Temperature)> handler_;
+
+        std::shared_ptr<LinkedDeviceHandler> next_event_handler_;
+
+    public:
+        template <typename TCanHandle, typename TEventHandler>
+        LinkedDeviceHandler(TCanHandle&& can_handle, TEventHandler&& handler)
+            : can_handle_{std::forward<TCanHandle>(can_handle)}
+            , handler_{std::forward<TEventHandler>(handler)}
+        { }
+
+        void set_next_handler(std::shared_ptr<LinkedDeviceHandler> next_handler)
+        {
+            next_event_handler_ = next_handler;
+        }
+
+        void on_temperature_event(Temperature temperature)
+        {
+            if (can_handle_(temperature))
+                handler_(temperature);
+
+            if (next_event_handler_)
+                next_event_handler_->on_temperature_event(temperature);
+        }
+    };
+
+    class LinkedDevice
+    {
+        std::shared_ptr<LinkedDeviceHandler> handler_;
+
+    public:
+        template <typename TCanHandle, typename TDeviceHandler>
+        void add_handler(TCanHandle&& can_handle, TDeviceHandler&& handler)
+        {
+            auto new_handler = std::make_shared<LinkedDeviceHandler>(std::forward<TCanHandle>(can_handle), std::forward<TDeviceHandler>(handler));
+            new_handler->set_next_handler(handler_);
+            handler_ = new_handler;
+        }
+
+        void on_temperature_change(Temperature temperature)
+        {
+            if (handler_)
+                handler_->on_temperature_event(temperature);
+        }
+    };
+
+    // Readings between 15 and 30 degrees, handlers match a random 2 degree wide range
+    std::vector<Temperature> readings()
+    {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<Temperature> temperature{15.0, 30.0};
+
+        std::vector<Temperature> result(1024);
+        for (auto& t : result)
+            t = temperature(gen);
+        return result;
+    }
+
+    // Readings of a real sensor - slowly changing between 15 and 30 degrees, with some noise
+    std::vector<Temperature> sensor_log()
+    {
+        std::mt19937 gen{42};
+        std::normal_distribution<Temperature> noise{0.0, 0.05};
+
+        std::vector<Temperature> result(1024);
+        for (std::size_t i = 0; i < result.size(); ++i)
+            result[i] = 22.5 + 7.0 * std::sin(i / 100.0) + noise(gen);
+        return result;
+    }
+
+    // Opaque predicate - evaluated for every event
+    auto in_range = [](Temperature from) {
+        return [from](Temperature t) { return t >= from && t < from + 2.0; };
+    };
+
+    // The same range built from matchers - indexed by Device
+    auto in_range_matcher = [](Temperature from) {
+        using namespace Matchers;
+        return And(Ge(from), Lt(from + 2.0));
+    };
+
+    template <typename TDevice, typename TMakeMatcher, typename... TTrigger>
+    void add_handlers(TDevice& device, std::size_t count, std::size_t& hits, TMakeMatcher make_matcher, TTrigger... trigger)
+    {
+        std::mt19937 gen{7};
+        std::uniform_real_distribution<Temperature> low{15.0, 28.0};
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Temperature from = low(gen);
+            device.add_handler(make_matcher(from), [&hits](Temperature) { ++hits; }, trigger...);
+        }
+    }
+
+    template <typename TDevice, typename TMakeMatcher>
+    void run_events(benchmark::State& state, TDevice& device, TMakeMatcher make_matcher, const std::vector<Temperature>& events = readings())
+    {
+        std::size_t hits = 0;
+        add_handlers(device, static_cast<std::size_t>(state.range(0)), hits, make_matcher);
+
+        for (auto _ : state)
+        {
+            for (Temperature t : events)
+                device.on_temperature_change(t);
+        }
+
+        benchmark::DoNotOptimize(hits);
+        state.SetItemsProcessed(state.iterations() * events.size());
+    }
+
+    void run_batch_events(benchmark::State& state, const std::vector<Temperature>& events, Trigger trigger = Trigger::level)
+    {
+        Device device{"benchmark"};
+        std::size_t hits = 0;
+        add_handlers(device, static_cast<std::size_t>(state.range(0)), hits, in_range_matcher, trigger);
+
+        for (auto _ : state)
+            device.on_temperature_changes(events);
+
+        benchmark::DoNotOptimize(hits);
+        state.SetItemsProcessed(state.iterations() * events.size());
+        state.counters["calls/reading"] = static_cast<double>(hits) / (state.iterations() * events.size());
+    }
+}
+
+static void BM_Device_Events(benchmark::State& state)
+{
+    Device device{"benchmark"};
+    run_events(state, device, in_range);
+}
+BENCHMARK(BM_Device_Events)->RangeMultiplier(10)->Range(10, 10'000);
+
+static void BM_Device_IndexedEvents(benchmark::State& state)
+{
+    Device device{"benchmark"};
+    run_events(state, device, in_range_matcher);
+}
+BENCHMARK(BM_Device_IndexedEvents)->RangeMultiplier(10)->Range(10, 10'000);
+
+static void BM_Device_BatchEvents(benchmark::State& state)
+{
+    run_batch_events(state, readings());
+}
+BENCHMARK(BM_Device_BatchEvents)->RangeMultiplier(10)->Range(10, 10'000);
+
+static void BM_Device_SensorLog(benchmark::State& state)
+{
+    Device device{"benchmark"};
+    run_events(state, device, in_range_matcher, sensor_log());
+}
+BENCHMARK(BM_Device_SensorLog)->RangeMultiplier(10)->Range(10, 10'000);
+
+static void BM_Device_BatchSensorLog(benchmark::State& state)
+{
+    run_batch_events(state, sensor_log());
+}
+BENCHMARK(BM_Device_BatchSensorLog)->RangeMultiplier(10)->Range(10, 10'000);
+
+static void BM_Device_EdgeBatchSensorLog(benchmark::State& state)
+{
+    run_batch_events(state, sensor_log(), Trigger::edge);
+}
+BENCHMARK(BM_Device_EdgeBatchSensorLog)->RangeMultiplier(10)->Range(10, 10'000);
+
+static void BM_LinkedDevice_Events(benchmark::State& state)
+{
+    LinkedDevice device;
+    run_events(state, device, in_range);
+}
+BENCHMARK(BM_LinkedDevice_Events)->RangeMultiplier(10)->Range(10, 10'000);
@@ -0,0 +1,120 @@
+#include "chain.hpp"
+#include "handler_chain.hpp"
+#include "matchers.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace Matchers;
+
+namespace
+{
+    std::vector<Temperature> predicate_readings()
+    {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<Temperature> temperature{15.0, 30.0};
+
+        std::vector<Temperature> result(1024);
+        for (auto& t : result)
+            t = temperature(gen);
+        return result;
+    }
+
+    // Not an interval - Device can't index it and has to evaluate it for every reading
+    auto comfortable(Temperature from)
+    {
+        return Or(And(Ge(from), Lt(from + 2.0)), Not(Gt(from - 5.0)));
+    }
+
+    using Comfortable = decltype(comfortable(0.0));
+
+    template <typename TPredicate>
+    void evaluate_predicates(benchmark::State& state, const std::vector<TPredicate>& predicates)
+    {
+        const auto readings = predicate_readings();
+        std::size_t matches = 0;
+
+        for (auto _ : state)
+        {
+            for (const Temperature t : readings)
+                for (const auto& predicate : predicates)
+                    matches += predicate(t);
+        }
+
+        benchmark::DoNotOptimize(matches);
+        state.SetItemsProcessed(state.iterations() * readings.size() * predicates.size());
+    }
+}
+
+static void BM_Predicate_StdFunction(benchmark::State& state)
+{
+    std::vector<std::function<bool(Temperature)>> predicates;
+    for (int i = 0; i < 16; ++i)
+        predicates.emplace_back(comfortable(15.0 + i));
+
+    evaluate_predicates(state, predicates);
+}
+BENCHMARK(BM_Predicate_StdFunction);
+
+static void BM_Predicate_Inlined(benchmark::State& state)
+{
+    std::vector<Comfortable> predicates;
+    for (int i = 0; i < 16; ++i)
+        predicates.push_back(comfortable(15.0 + i));
+
+    evaluate_predicates(state, predicates);
+}
+BENCHMARK(BM_Predicate_Inlined);
+
+namespace
+{
+    struct Counters
+    {
+        std::size_t cold = 0;
+        std::size_t comfortable = 0;
+        std::size_t warm = 0;
+        std::size_t hot = 0;
+    };
+}
+
+// Four opaque handlers - every one is a std::function predicate and a std::function action
+static void BM_Device_OpaqueHandlers(benchmark::State& state)
+{
+    Counters counters;
+    Device device{"opaque"};
+    device.add_handler(Not(Ge(19.0)), [&counters](Temperature) { ++counters.cold; });
+    device.add_handler(comfortable(20.0), [&counters](Temperature) { ++counters.comfortable; });
+    device.add_handler(comfortable(23.0), [&counters](Temperature) { ++counters.warm; });
+    device.add_handler(Not(Lt(26.0)), [&counters](Temperature) { ++counters.hot; });
+
+    const auto readings = predicate_readings();
+    for (auto _ : state)
+        device.on_temperature_changes(readings);
+
+    benchmark::DoNotOptimize(counters);
+    state.SetItemsProcessed(state.iterations() * readings.size());
+}
+BENCHMARK(BM_Device_OpaqueHandlers);
+
+// The same handlers (in chain order) as one HandlerChain - type erased once
+static void BM_Device_HandlerChain(benchmark::State& state)
+{
+    Counters counters;
+    Device device{"static"};
+    device.add_handler(_, make_handler_chain(
+        make_handler(Not(Lt(26.0)), [&counters](Temperature) { ++counters.hot; }),
+        make_handler(comfortable(23.0), [&counters](Temperature) { ++counters.warm; }),
+        make_handler(comfortable(20.0), [&counters](Temperature) { ++counters.comfortable; }),
+        make_handler(Not(Ge(19.0)), [&counters](Temperature) { ++counters.cold; })));
+
+    const auto readings = predicate_readings();
+    for (auto _ : state)
+        device.on_temperature_changes(readings);
+
+    benchmark::DoNotOptimize(counters);
+    state.SetItemsProcessed(state.iterations() * readings.size());
+}
+BENCHMARK(BM_Device_HandlerChain);
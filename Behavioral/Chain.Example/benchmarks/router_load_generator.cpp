@@ -0,0 +1,146 @@
+// Load generator for DeviceRouter - producer threads post readings of random devices, the
+// throughput and the latency from post() to dispatch are reported at the end.
+//
+// usage: router_load_generator [devices] [shards] [producers] [readings] [readings per second, 0 - unlimited]
+
+#include "device_router.hpp"
+#include "matchers.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Thermostat
+    {
+        std::uint32_t heating = 0;
+        std::uint32_t cooling = 0;
+        std::uint32_t readings = 0;
+    };
+
+    // xorshift - cheap enough not to show in the throughput
+    class Random
+    {
+        std::uint64_t state_;
+
+    public:
+        explicit Random(std::uint64_t seed)
+            : state_{seed * 0x9E3779B97F4A7C15ull + 1}
+        {
+        }
+
+        std::uint64_t next()
+        {
+            state_ ^= state_ << 13;
+            state_ ^= state_ >> 7;
+            state_ ^= state_ << 17;
+            return state_;
+        }
+    };
+
+    const char* const usage = "usage: router_load_generator [devices] [shards] [producers] [readings] [readings per second, 0 - unlimited]";
+
+    // Keeps the default value if the argument is not given - false if it is not a number >= min_value
+    bool parse_argument(int argc, char* argv[], int index, std::size_t min_value, std::size_t& value)
+    {
+        if (argc <= index)
+            return true;
+
+        const char* const first = argv[index];
+        const char* const last = first + std::strlen(first);
+        std::size_t parsed;
+        const auto [end, error] = std::from_chars(first, last, parsed);
+        if (error != std::errc{} || end != last || parsed < min_value)
+            return false;
+
+        value = parsed;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t device_count = 100'000;
+    std::size_t shard_count = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t producer_count = 2;
+    std::size_t reading_count = 10'000'000;
+    std::size_t rate = 0;
+
+    if (argc > 6 || !parse_argument(argc, argv, 1, 1, device_count) || !parse_argument(argc, argv, 2, 1, shard_count)
+        || !parse_argument(argc, argv, 3, 1, producer_count) || !parse_argument(argc, argv, 4, 0, reading_count)
+        || !parse_argument(argc, argv, 5, 0, rate))
+    {
+        std::cerr << usage << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    DeviceRouter router{RouterOptions{shard_count}};
+    std::vector<Thermostat> thermostats(device_count);
+
+    using namespace Matchers;
+    for (std::size_t i = 0; i < device_count; ++i)
+    {
+        Device& device = router.device(router.add_device("thermostat-" + std::to_string(i)));
+        Thermostat& thermostat = thermostats[i];
+
+        device.add_handler(Lt(19.0), [&thermostat](Temperature) { ++thermostat.heating; }, Trigger::edge);
+        device.add_handler(Ge(25.0), [&thermostat](Temperature) { ++thermostat.cooling; }, Trigger::edge);
+        device.add_handler(_, [&thermostat](Temperature) { ++thermostat.readings; });
+    }
+
+    std::cout << device_count << " devices, " << shard_count << " shards, " << producer_count << " producers, " << reading_count
+              << " readings";
+    if (rate)
+        std::cout << " at " << rate << "/s";
+    std::cout << std::endl;
+
+    router.start();
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < producer_count; ++p)
+    {
+        producers.emplace_back([&, p] {
+            Random random{p + 1};
+            const std::size_t count = reading_count / producer_count + (p < reading_count % producer_count);
+            const double interval_ns = rate ? 1e9 * producer_count / rate : 0.0;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (rate && i % 256 == 0) // open loop - keep the schedule even if the router lags
+                    std::this_thread::sleep_until(start + std::chrono::nanoseconds{static_cast<std::int64_t>(i * interval_ns)});
+
+                const std::uint64_t value = random.next();
+                const auto device = static_cast<DeviceKey>(value % device_count);
+                const Temperature temperature = 15.0 + (value >> 32) % 150 / 10.0;
+                router.post(device, temperature);
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+    router.stop();
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const LatencyHistogram latency = router.latency();
+
+    std::size_t handled = 0;
+    for (const auto& thermostat : thermostats)
+        handled += thermostat.readings;
+
+    std::cout << std::fixed << std::setprecision(3) << "elapsed:    " << elapsed.count() << " s\n"
+              << std::setprecision(0) << "throughput: " << router.dispatched() / elapsed.count() << " readings/s ("
+              << handled << " handled)\n"
+              << "latency:    p50 <= " << latency.percentile(0.5).count() << " ns, p99 <= " << latency.percentile(0.99).count()
+              << " ns, p99.9 <= " << latency.percentile(0.999).count() << " ns, max " << latency.max.count() << " ns\n";
+}
@@ -1,51 +1,131 @@
 #ifndef CHAIN_HPP_
 #define CHAIN_HPP_
 
+#include "interval_index.hpp"
+#include "matchers.hpp"
+
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iostream>
-#include <memory>
+#include <iterator>
+#include <limits>
 #include <optional>
 #include <string>
+#include <vector>
 
-using Temperature = double;
+// Level-triggered handler is called for every reading its predicate accepts; edge-triggered
+// only when the predicate becomes true - for the first of consecutive accepted readings
+enum class Trigger
+{
+    level,
+    edge
+};
 
 class DeviceHandler
 {
     std::function<bool(Temperature)> can_handle_;
     std::function<void(Temperature)> handler_;
-
-    std::shared_ptr<DeviceHandler> next_event_handler_;
+    Trigger trigger_;
+    std::uint64_t last_accepted_ = 0; // number of the last reading accepted by the predicate (0 - none)
 
 public:
     template <typename TCanHandle, typename TEventHandler>
-    DeviceHandler(TCanHandle&& can_handle, TEventHandler&& handler)
+    DeviceHandler(TCanHandle&& can_handle, TEventHandler&& handler, Trigger trigger = Trigger::level)
         : can_handle_{std::forward<TCanHandle>(can_handle)}
         , handler_{std::forward<TEventHandler>(handler)}
+        , trigger_{trigger}
     { }
 
-    void set_next_handler(std::shared_ptr<DeviceHandler> next_handler)
+    bool can_handle(Temperature temperature) const
+    {
+        return can_handle_(temperature);
+    }
+
+    Trigger trigger() const
     {
-        next_event_handler_ = next_handler;
+        return trigger_;
     }
 
-    void on_temperature_event(Temperature temperature)
+    void on_temperature_event(Temperature temperature, std::uint64_t reading)
     {
         if (can_handle_(temperature))
-            handler_(temperature);
+            handle(temperature, reading);
+    }
 
-        if (next_event_handler_)
+    // For readings accepted by the predicate - callers that already know it holds skip the check
+    void handle(Temperature temperature, std::uint64_t reading)
+    {
+        if (trigger_ == Trigger::edge)
         {
-            next_event_handler_->on_temperature_event(temperature);
+            const bool accepted_before = last_accepted_ != 0 && last_accepted_ + 1 >= reading;
+            last_accepted_ = std::max(last_accepted_, reading);
+            if (accepted_before)
+                return;
         }
-    }
 
-    ~DeviceHandler() = default;
+        handler_(temperature);
+    }
 };
 
+// The chain of handlers is kept in a contiguous array. A handler added later is earlier in the
+// chain (as if it was linked in front of the previous ones), so handlers are dispatched from the
+// last added to the first.
+//
+// Handlers whose predicate exposes an interval (Matchers::Lt, Ge, And(Ge, Lt), ...) are indexed
+// in an interval tree, so an event finds the k matching ones in O(log n + k) instead of evaluating
+// every predicate. The matches are put in chain order with a bit per handler (n / 64 words to scan).
+// Opaque predicates (lambdas, Or, Not) are still evaluated one by one, interleaved with the
+// matching indexed handlers in chain order.
+//
+// An edge-triggered handler (Trigger::edge) remembers the number of the last reading its
+// predicate accepted, so readings it does not accept cost nothing extra.
+//
+// A batch of readings is dispatched as if each was sent on its own, but the interval predicates
+// are evaluated over chunks of 64 readings at once into per-handler hit masks.
+// Handlers must not add handlers to the device they are called by.
 class Device
 {
+    struct Bounds
+    {
+        Temperature low;
+        Temperature high;
+    };
+
+    static constexpr std::size_t batch_chunk = 64;
+
     std::string id_;
-    std::shared_ptr<DeviceHandler> handler_;
+    std::vector<DeviceHandler> handlers_; // in order of adding
+    std::vector<std::size_t> opaque_handlers_; // indexes of handlers without an interval, ascending
+    std::vector<Bounds> closures_; // of the interval of each handler (empty for opaque ones)
+    IntervalIndex index_;
+    bool index_built_ = false;
+    std::vector<std::uint64_t> hits_; // bit per handler, all zero between events
+    std::vector<std::vector<std::size_t>> batch_hits_; // matching indexed handlers of each reading in a chunk (allocated by the first batch)
+    int dispatch_depth_ = 0;
+    std::uint64_t readings_ = 0; // count of dispatched readings
+
+    struct DispatchScope
+    {
+        int& depth;
+
+        ~DispatchScope()
+        {
+            --depth;
+        }
+    };
+
+    static std::size_t highest_bit(std::uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<std::size_t>(__builtin_clzll(word));
+#else
+        std::size_t bit = 0;
+        for (std::size_t shift = 32; shift > 0; shift >>= 1)
+            bit += static_cast<std::size_t>(word >> (bit + shift) != 0) * shift;
+        return bit;
+#endif
+    }
 
 public:
     Device(std::string id)
@@ -53,18 +133,233 @@ public:
     {
     }
 
+    const std::string& id() const
+    {
+        return id_;
+    }
+
     template <typename TCanHandle, typename TDeviceHandler>
-    void add_handler(TCanHandle&& can_handle, TDeviceHandler&& handler)
+    void add_handler(TCanHandle&& can_handle, TDeviceHandler&& handler, Trigger trigger = Trigger::level)
+    {
+        const std::size_t position = handlers_.size();
+
+        if constexpr (Matchers::has_interval_v<TCanHandle>)
+        {
+            const Matchers::Interval interval = can_handle.interval();
+            const Matchers::Interval closure = interval.closure();
+            index_.add(interval, position);
+            closures_.push_back(Bounds{closure.low, closure.high});
+        }
+        else
+        {
+            opaque_handlers_.push_back(position);
+            closures_.push_back(Bounds{std::numeric_limits<Temperature>::infinity(), -std::numeric_limits<Temperature>::infinity()});
+        }
+
+        handlers_.emplace_back(std::forward<TCanHandle>(can_handle), std::forward<TDeviceHandler>(handler), trigger);
+        index_built_ = false;
+    }
+
+    std::size_t handler_count() const
     {
-        auto new_handler = std::make_shared<DeviceHandler>(std::forward<TCanHandle>(can_handle), std::forward<TDeviceHandler>(handler));
-        new_handler->set_next_handler(handler_);
-        handler_ = new_handler;
+        return handlers_.size();
     }
 
     void on_temperature_change(Temperature temperature)
     {
-        if (handler_)
-            handler_->on_temperature_event(temperature);
+        // a nested event (sent by a handler) must not reuse hits_ of the outer one
+        if (dispatch_depth_ > 0)
+        {
+            dispatch_linear(temperature);
+            return;
+        }
+
+        build_index();
+
+        DispatchScope scope{++dispatch_depth_};
+        dispatch_indexed(temperature);
+    }
+
+    // Same as on_temperature_change() for each reading in order. Chunks of readings in a narrow range
+    // (e.g. a sensor log) evaluate their candidate interval predicates over the whole chunk at once.
+    void on_temperature_changes(const Temperature* temperatures, std::size_t count)
+    {
+        if (dispatch_depth_ > 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                dispatch_linear(temperatures[i]);
+            return;
+        }
+
+        build_index();
+
+        DispatchScope scope{++dispatch_depth_};
+        for (std::size_t first = 0; first < count; first += batch_chunk)
+            dispatch_chunk(temperatures + first, std::min(batch_chunk, count - first));
+    }
+
+    template <typename TContainer>
+    void on_temperature_changes(const TContainer& temperatures)
+    {
+        on_temperature_changes(std::data(temperatures), std::size(temperatures));
+    }
+
+private:
+    void build_index()
+    {
+        if (!index_built_)
+        {
+            index_.build();
+            hits_.assign(handlers_.size() / 64 + 1, 0);
+            index_built_ = true;
+        }
+    }
+
+    void dispatch_linear(Temperature temperature)
+    {
+        const std::uint64_t reading = ++readings_;
+        for (auto it = handlers_.rbegin(); it != handlers_.rend(); ++it)
+            it->on_temperature_event(temperature, reading);
+    }
+
+    void dispatch_indexed(Temperature temperature)
+    {
+        // NaN is outside of every interval, but AnyMatcher and opaque predicates may still accept it
+        if (temperature != temperature)
+        {
+            dispatch_linear(temperature);
+            return;
+        }
+
+        const std::uint64_t reading = ++readings_;
+        std::size_t first_word = hits_.size();
+        std::size_t last_word = 0;
+        index_.find(temperature, [&](std::size_t position) {
+            hits_[position / 64] |= std::uint64_t{1} << (position % 64);
+            first_word = std::min(first_word, position / 64);
+            last_word = std::max(last_word, position / 64);
+        });
+
+        // leaves hits_ cleared even if a handler throws
+        struct ClearHits
+        {
+            std::vector<std::uint64_t>& hits;
+            std::size_t first_word;
+            std::size_t last_word;
+
+            ~ClearHits()
+            {
+                for (std::size_t word = first_word; word <= last_word; ++word)
+                    hits[word] = 0;
+            }
+        } clear_hits{hits_, first_word, last_word};
+
+        auto opaque = opaque_handlers_.rbegin();
+        for (std::size_t word = last_word + 1; word-- > first_word;)
+        {
+            for (std::uint64_t bits = hits_[word]; bits != 0;)
+            {
+                const std::size_t bit = highest_bit(bits);
+                bits &= ~(std::uint64_t{1} << bit);
+                const std::size_t position = word * 64 + bit;
+
+                for (; opaque != opaque_handlers_.rend() && *opaque > position; ++opaque)
+                    handlers_[*opaque].on_temperature_event(temperature, reading);
+                handlers_[position].handle(temperature, reading);
+            }
+        }
+        for (; opaque != opaque_handlers_.rend(); ++opaque)
+            handlers_[*opaque].on_temperature_event(temperature, reading);
+    }
+
+    void dispatch_chunk(const Temperature* temperatures, std::size_t size)
+    {
+        auto low = std::numeric_limits<Temperature>::infinity();
+        auto high = -std::numeric_limits<Temperature>::infinity();
+        for (std::size_t i = 0; i < size; ++i) // NaN is skipped
+        {
+            low = temperatures[i] < low ? temperatures[i] : low;
+            high = temperatures[i] > high ? temperatures[i] : high;
+        }
+
+        // handlers whose interval overlaps the range of the chunk
+        std::size_t candidates = 0;
+        std::size_t first_word = hits_.size();
+        std::size_t last_word = 0;
+        if (low <= high)
+        {
+            index_.find(low, high, [&](std::size_t position) {
+                hits_[position / 64] |= std::uint64_t{1} << (position % 64);
+                first_word = std::min(first_word, position / 64);
+                last_word = std::max(last_word, position / 64);
+                ++candidates;
+            });
+        }
+
+        // a mask costs about as much as one lookup in the index - for widely spread readings it is
+        // cheaper to look up each reading
+        if (candidates > batch_chunk)
+        {
+            for (std::size_t word = first_word; word <= last_word; ++word)
+                hits_[word] = 0;
+
+            for (std::size_t i = 0; i < size; ++i)
+                dispatch_indexed(temperatures[i]);
+            return;
+        }
+
+        batch_hits_.resize(batch_chunk);
+        for (std::size_t i = 0; i < size; ++i)
+            batch_hits_[i].clear();
+
+        // from the last added handler, so every batch_hits_[i] is in chain order
+        for (std::size_t word = last_word + 1; word-- > first_word;)
+        {
+            std::uint64_t bits = hits_[word];
+            hits_[word] = 0;
+
+            while (bits != 0)
+            {
+                const std::size_t bit = highest_bit(bits);
+                bits &= ~(std::uint64_t{1} << bit);
+                const std::size_t position = word * 64 + bit;
+
+                const Bounds closure = closures_[position];
+                std::uint64_t mask = 0;
+                for (std::size_t i = 0; i < size; ++i)
+                    mask |= static_cast<std::uint64_t>((closure.low <= temperatures[i]) & (temperatures[i] <= closure.high)) << i;
+
+                while (mask != 0)
+                {
+                    const std::size_t i = highest_bit(mask);
+                    mask &= ~(std::uint64_t{1} << i);
+                    batch_hits_[i].push_back(position);
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const Temperature temperature = temperatures[i];
+
+            if (temperature != temperature)
+            {
+                dispatch_linear(temperature);
+                continue;
+            }
+
+            const std::uint64_t reading = ++readings_;
+
+            auto opaque = opaque_handlers_.rbegin();
+            for (const std::size_t position : batch_hits_[i])
+            {
+                for (; opaque != opaque_handlers_.rend() && *opaque > position; ++opaque)
+                    handlers_[*opaque].on_temperature_event(temperature, reading);
+                handlers_[position].handle(temperature, reading);
+            }
+            for (; opaque != opaque_handlers_.rend(); ++opaque)
+                handlers_[*opaque].on_temperature_event(temperature, reading);
+        }
     }
 };
 
@@ -0,0 +1,331 @@
+#ifndef DEVICE_ROUTER_HPP_
+#define DEVICE_ROUTER_HPP_
+
+#include "chain.hpp"
+#include "mpsc_queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using DeviceKey = std::uint32_t;
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Histogram of latencies - bucket i counts latencies in [2^(i-1), 2^i) ns, bucket 0 is under 1 ns
+struct LatencyHistogram
+{
+    static constexpr std::size_t bucket_count = 48;
+
+    std::size_t count = 0;
+    std::chrono::nanoseconds max{0};
+    std::array<std::size_t, bucket_count> buckets{};
+
+    void record(std::chrono::nanoseconds latency)
+    {
+        ++count;
+        if (latency > max)
+            max = latency;
+
+        std::size_t bucket = 0;
+        for (auto ns = static_cast<std::uint64_t>(latency.count()); ns != 0 && bucket < bucket_count - 1; ns >>= 1)
+            ++bucket;
+        ++buckets[bucket];
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        count += other.count;
+        if (other.max > max)
+            max = other.max;
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket)
+            buckets[bucket] += other.buckets[bucket];
+    }
+
+    // Upper bound of the bucket containing the given fraction (0.0 - 1.0) of latencies
+    std::chrono::nanoseconds percentile(double fraction) const
+    {
+        const auto rank = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(fraction * count)));
+        std::size_t seen = 0;
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket)
+        {
+            seen += buckets[bucket];
+            if (seen >= rank)
+                return std::min(max, std::chrono::nanoseconds{std::int64_t{1} << bucket});
+        }
+        return max;
+    }
+};
+
+struct RouterOptions
+{
+    std::size_t shard_count = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t queue_capacity = 64 * 1024; // per shard
+    bool record_latency = true;             // from post() to the start of dispatch
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Routes temperature readings to many devices. Devices are split into shards (by key), every
+// shard has its own worker thread and a lock-free queue the producers post readings to - a
+// device is only touched by the worker of its shard, so devices and handlers need no locks.
+// Readings posted for a device by one thread are dispatched in the order they were posted.
+//
+// Devices are added and configured before start(); post() may be called from any threads between
+// start() and stop().
+class DeviceRouter
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Event
+    {
+        DeviceKey device;
+        Temperature temperature;
+        Clock::time_point posted_at;
+    };
+
+    class Shard
+    {
+        MpscQueue<Event> queue_;
+        std::size_t shard_count_;
+        bool record_latency_;
+
+        std::atomic<bool> stopping_{false};
+        std::atomic<bool> sleeping_{false};
+        std::mutex wake_mutex_;
+        std::condition_variable wake_;
+
+        alignas(64) std::atomic<std::size_t> dispatched_{0};
+        LatencyHistogram latency_; // worker only until it is joined
+
+        std::thread worker_;
+
+    public:
+        std::deque<Device> devices; // device with key k is devices[k / shard_count]
+
+        Shard(std::size_t queue_capacity, std::size_t shard_count, bool record_latency)
+            : queue_{queue_capacity}, shard_count_{shard_count}, record_latency_{record_latency}
+        {
+        }
+
+        void start()
+        {
+            stopping_ = false;
+            worker_ = std::thread{[this] { run(); }};
+        }
+
+        // Dispatches the readings already posted and joins the worker
+        void stop()
+        {
+            if (!worker_.joinable())
+                return;
+
+            stopping_ = true;
+            {
+                std::lock_guard lk{wake_mutex_};
+                wake_.notify_one();
+            }
+            worker_.join();
+        }
+
+        void push(const Event& event)
+        {
+            while (!queue_.try_push(event))
+            {
+                wake_worker();
+                std::this_thread::yield();
+            }
+
+            wake_worker();
+        }
+
+        std::size_t dispatched() const
+        {
+            return dispatched_.load();
+        }
+
+        const LatencyHistogram& latency() const
+        {
+            return latency_;
+        }
+
+    private:
+        void wake_worker()
+        {
+            // pairs with the fence in run() - either the worker sees the event or we see it sleeping
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleeping_.load(std::memory_order_relaxed))
+            {
+                std::lock_guard lk{wake_mutex_};
+                wake_.notify_one();
+            }
+        }
+
+        void run()
+        {
+            Event event;
+
+            while (true)
+            {
+                if (queue_.try_pop(event))
+                {
+                    dispatch(event);
+                    continue;
+                }
+
+                if (stopping_)
+                {
+                    if (queue_.try_pop(event))
+                    {
+                        dispatch(event);
+                        continue;
+                    }
+                    break;
+                }
+
+                std::unique_lock lk{wake_mutex_};
+                sleeping_ = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wake_.wait(lk, [this] { return queue_.size() > 0 || stopping_; });
+                sleeping_ = false;
+            }
+        }
+
+        void dispatch(const Event& event)
+        {
+            if (record_latency_)
+                latency_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - event.posted_at));
+
+            devices[event.device / shard_count_].on_temperature_change(event.temperature);
+            dispatched_.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::unordered_map<std::string, DeviceKey> keys_;
+    DeviceKey device_count_ = 0;
+    bool record_latency_;
+    std::atomic<bool> running_{false};
+
+public:
+    explicit DeviceRouter(RouterOptions options = {})
+        : record_latency_{options.record_latency}
+    {
+        if (options.shard_count == 0)
+            throw std::invalid_argument{"Router needs at least one shard"};
+
+        for (std::size_t i = 0; i < options.shard_count; ++i)
+            shards_.push_back(std::make_unique<Shard>(options.queue_capacity, options.shard_count, options.record_latency));
+    }
+
+    DeviceRouter(const DeviceRouter&) = delete;
+    DeviceRouter& operator=(const DeviceRouter&) = delete;
+
+    // readings already posted are dispatched
+    ~DeviceRouter()
+    {
+        stop();
+    }
+
+    std::size_t shard_count() const
+    {
+        return shards_.size();
+    }
+
+    std::size_t device_count() const
+    {
+        return device_count_;
+    }
+
+    DeviceKey add_device(const std::string& id)
+    {
+        if (running_)
+            throw std::logic_error{"Devices can't be added to a running router"};
+        if (keys_.count(id))
+            throw std::invalid_argument{"Device " + id + " already exists"};
+
+        const DeviceKey key = device_count_++;
+        shards_[key % shards_.size()]->devices.emplace_back(id);
+        keys_.emplace(id, key);
+        return key;
+    }
+
+    std::optional<DeviceKey> find(const std::string& id) const
+    {
+        auto it = keys_.find(id);
+        if (it == keys_.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    // Not to be used while the router is running - the device belongs to a worker then
+    Device& device(DeviceKey key)
+    {
+        if (key >= device_count_)
+            throw std::out_of_range{"Unknown device key"};
+        return shards_[key % shards_.size()]->devices[key / shards_.size()];
+    }
+
+    void start()
+    {
+        if (running_)
+            return;
+
+        for (auto& shard : shards_)
+            shard->start();
+        running_ = true;
+    }
+
+    // Dispatches all readings posted so far and stops the workers
+    void stop()
+    {
+        if (!running_)
+            return;
+
+        for (auto& shard : shards_)
+            shard->stop();
+        running_ = false;
+    }
+
+    // Thread safe; blocks while the queue of the shard is full. Only while the router is running -
+    // with no worker to drain it a full queue would block forever.
+    void post(DeviceKey key, Temperature temperature)
+    {
+        if (key >= device_count_)
+            throw std::out_of_range{"Unknown device key"};
+        if (!running_.load(std::memory_order_relaxed))
+            throw std::logic_error{"Router not running"};
+
+        shards_[key % shards_.size()]->push(Event{key, temperature, record_latency_ ? Clock::now() : Clock::time_point{}});
+    }
+
+    std::size_t dispatched() const
+    {
+        std::size_t result = 0;
+        for (const auto& shard : shards_)
+            result += shard->dispatched();
+        return result;
+    }
+
+    // Latencies of all shards - valid after stop()
+    LatencyHistogram latency() const
+    {
+        LatencyHistogram result;
+        for (const auto& shard : shards_)
+            result.merge(shard->latency());
+        return result;
+    }
+};
+
+#endif /*DEVICE_ROUTER_HPP_*/
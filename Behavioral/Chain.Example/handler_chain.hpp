@@ -0,0 +1,72 @@
+#ifndef HANDLER_CHAIN_HPP_
+#define HANDLER_CHAIN_HPP_
+
+#include "matchers.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template <typename TCanHandle, typename TAction>
+struct StaticHandler
+{
+    TCanHandle can_handle;
+    TAction action;
+};
+
+template <typename TCanHandle, typename TAction>
+StaticHandler<std::decay_t<TCanHandle>, std::decay_t<TAction>> make_handler(TCanHandle&& can_handle, TAction&& action)
+{
+    return {std::forward<TCanHandle>(can_handle), std::forward<TAction>(action)};
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Chain of handlers fixed at compile time - predicates and actions keep their own types (no
+// std::function), so a whole chain compiles into one function with the matcher expressions
+// inlined. Handlers are called in the order they are listed.
+//
+// The chain is a single callable, type erased only where it is added to a Device:
+//     device.add_handler(Matchers::_, make_handler_chain(make_handler(Lt(19.0), heat), ...));
+template <typename... THandlers>
+class HandlerChain
+{
+    std::tuple<THandlers...> handlers_;
+
+public:
+    explicit HandlerChain(THandlers... handlers)
+        : handlers_{std::move(handlers)...}
+    {
+    }
+
+    static constexpr std::size_t size()
+    {
+        return sizeof...(THandlers);
+    }
+
+    void on_temperature_change(Temperature temperature)
+    {
+        std::apply([temperature](auto&... handlers) { (dispatch(handlers, temperature), ...); }, handlers_);
+    }
+
+    void operator()(Temperature temperature)
+    {
+        on_temperature_change(temperature);
+    }
+
+private:
+    template <typename THandler>
+    static void dispatch(THandler& handler, Temperature temperature)
+    {
+        if (handler.can_handle(temperature))
+            handler.action(temperature);
+    }
+};
+
+template <typename... THandlers>
+HandlerChain<std::decay_t<THandlers>...> make_handler_chain(THandlers&&... handlers)
+{
+    return HandlerChain<std::decay_t<THandlers>...>{std::forward<THandlers>(handlers)...};
+}
+
+#endif /*HANDLER_CHAIN_HPP_*/
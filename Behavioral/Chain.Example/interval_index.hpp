@@ -0,0 +1,160 @@
+#ifndef INTERVAL_INDEX_HPP_
+#define INTERVAL_INDEX_HPP_
+
+#include "matchers.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Static interval tree answering "which intervals contain t" in O(log n + k).
+//
+// Intervals are sorted by their low bound and the sorted array is itself the tree: the node at
+// index i on level k has children i -/+ 2^(k-1) (leaves are at even indices), and every node
+// keeps the maximal high bound of its subtree - subtrees ending below t are skipped.
+// (Implicit augmented tree, as in H. Li's cgranges.)
+class IntervalIndex
+{
+    struct Entry
+    {
+        Matchers::Interval interval;
+        Temperature max_high; // of the subtree rooted here
+        std::size_t value;
+    };
+
+    std::vector<Entry> entries_;
+    int max_level_ = 0;
+
+public:
+    void clear()
+    {
+        entries_.clear();
+        max_level_ = 0;
+    }
+
+    // Empty intervals are ignored
+    void add(const Matchers::Interval& interval, std::size_t value)
+    {
+        if (!interval.empty())
+            entries_.push_back(Entry{interval, interval.high, value});
+    }
+
+    std::size_t size() const
+    {
+        return entries_.size();
+    }
+
+    // Must be called after adding intervals, before the first query
+    void build()
+    {
+        std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) { return a.interval.low < b.interval.low; });
+
+        const std::int64_t n = static_cast<std::int64_t>(entries_.size());
+        if (n == 0)
+        {
+            max_level_ = 0;
+            return;
+        }
+
+        std::int64_t last_i = 0;
+        Temperature last = 0;
+        for (std::int64_t i = 0; i < n; i += 2)
+        {
+            last_i = i;
+            last = entries_[i].max_high = entries_[i].interval.high;
+        }
+
+        int k = 1;
+        for (; (std::int64_t{1} << k) <= n; ++k)
+        {
+            const std::int64_t x = std::int64_t{1} << (k - 1);
+            const std::int64_t first = (x << 1) - 1;
+            const std::int64_t step = x << 2;
+
+            for (std::int64_t i = first; i < n; i += step)
+            {
+                const Temperature left = entries_[i - x].max_high;
+                const Temperature right = i + x < n ? entries_[i + x].max_high : last;
+                entries_[i].max_high = std::max({entries_[i].interval.high, left, right});
+            }
+
+            // the rightmost node of the level may have its right subtree cut off by n
+            last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+            if (last_i < n && entries_[last_i].max_high > last)
+                last = entries_[last_i].max_high;
+        }
+
+        max_level_ = k - 1;
+    }
+
+    // Calls on_match(value) for every interval containing the temperature (in no particular order)
+    template <typename TOnMatch>
+    void find(Temperature temperature, TOnMatch&& on_match) const
+    {
+        visit(temperature, temperature, [&](const Entry& entry) {
+            if (entry.interval.contains(temperature))
+                on_match(entry.value);
+        });
+    }
+
+    // Calls on_match(value) for every interval overlapping [low, high] - and for intervals only
+    // touching it with an open bound
+    template <typename TOnMatch>
+    void find(Temperature low, Temperature high, TOnMatch&& on_match) const
+    {
+        visit(low, high, [&](const Entry& entry) {
+            if (entry.interval.high >= low)
+                on_match(entry.value);
+        });
+    }
+
+private:
+    // Visits (at least) all entries with low <= high and subtree max_high >= low
+    template <typename TVisitor>
+    void visit(Temperature low, Temperature high, TVisitor&& visitor) const
+    {
+        const std::int64_t n = static_cast<std::int64_t>(entries_.size());
+        if (n == 0)
+            return;
+
+        struct Frame
+        {
+            std::int64_t node;
+            int level;
+            bool left_done;
+        };
+
+        Frame stack[128];
+        int top = 0;
+        stack[top++] = Frame{(std::int64_t{1} << max_level_) - 1, max_level_, false};
+
+        while (top > 0)
+        {
+            const Frame frame = stack[--top];
+
+            if (frame.level <= 3) // small subtree - scan it
+            {
+                const std::int64_t first = frame.node >> frame.level << frame.level;
+                const std::int64_t last = std::min(n, first + (std::int64_t{1} << (frame.level + 1)) - 1);
+                for (std::int64_t i = first; i < last && entries_[i].interval.low <= high; ++i)
+                    visitor(entries_[i]);
+            }
+            else if (!frame.left_done)
+            {
+                const std::int64_t left = frame.node - (std::int64_t{1} << (frame.level - 1));
+                stack[top++] = Frame{frame.node, frame.level, true};
+                if (left >= n || entries_[left].max_high >= low)
+                    stack[top++] = Frame{left, frame.level - 1, false};
+            }
+            else if (frame.node < n && entries_[frame.node].interval.low <= high)
+            {
+                visitor(entries_[frame.node]);
+                stack[top++] = Frame{frame.node + (std::int64_t{1} << (frame.level - 1)), frame.level - 1, false};
+            }
+        }
+    }
+};
+
+#endif /*INTERVAL_INDEX_HPP_*/
@@ -1,4 +1,5 @@
 #include "chain.hpp"
+#include "matchers.hpp"
 
 #include <algorithm>
 #include <array>
@@ -68,48 +69,6 @@ public:
     }
 };
 
-namespace Matchers
-{
-    template <typename Compare>
-    struct Comparer
-    {
-        auto operator()(Temperature temperature) const
-        {
-            return [temperature, compare = Compare{}](Temperature value) {
-                return compare(value, temperature);
-            };
-        }
-    };
-
-    auto _ = [](Temperature temperature) {
-        return true;
-    };
-    // auto Lt = [](Temperature value) { return [value](Temperature temperature) { return temperature < value; }; };
-    auto Lt = Comparer<std::less<>>{};
-    auto Le = Comparer<std::less_equal<>>{};
-    auto Gt = Comparer<std::greater<>>{};
-    auto Ge = Comparer<std::greater_equal<>>{};
-    auto Eq = Comparer<std::equal_to<>>{};
-
-    auto And = [](auto&& lhs, auto&& rhs) {
-        return [lhs = std::forward<decltype(lhs)>(lhs), rhs = std::forward<decltype(rhs)>(rhs)](Temperature temperature) {
-            return lhs(temperature) && rhs(temperature);
-        };
-    };
-
-    auto Or = [](auto&& lhs, auto&& rhs) {
-        return [lhs = std::forward<decltype(lhs)>(lhs), rhs = std::forward<decltype(rhs)>(rhs)](Temperature temperature) {
-            return lhs(temperature) || rhs(temperature);
-        };
-    };
-
-    auto Not = [](auto&& pred) {
-        return [pred = std::forward<decltype(pred)>(pred)](Temperature temperature) {
-            return !pred(temperature);
-        };
-    };
-} // namespace Matchers
-
 int main()
 {
     std::cout << "Start...\n";
@@ -168,27 +127,31 @@ int main()
             turn_on_heater();
             turn_off_fan_1();
             turn_off_fan_2();
-        });
+        },
+        Trigger::edge);
 
     device.add_handler(/*[](Temperature temperature) { return temperature >= 20.0; },*/
         Ge(20.0),
         [&](Temperature temperature) {
             turn_off_heater();
-        });
+        },
+        Trigger::edge);
 
     device.add_handler(/*[](Temperature temperature) { return temperature >= 22.5 && temperature < 25; },*/
         And(Ge(22.5), Lt(25.0)),
         [&](Temperature temperature) {
             set_fan_speed(fan_1, 5)();
             turn_off_fan_2();
-        });
+        },
+        Trigger::edge);
 
     device.add_handler(/*[](Temperature temperature) { return temperature >= 25.0; },*/
         Ge(25.0),
         [&](Temperature temperature) {
             set_fan_speed(fan_1, 10)();
             set_fan_speed(fan_2, 10)();
-        });
+        },
+        Trigger::edge);
 
     device.add_handler(_,
         [&](Temperature temperature) {
@@ -199,6 +162,5 @@ int main()
     std::array temperatures = {18.0, 18.5, 19.0, 19.5, 20.0, 20.5, 21.0, 21.5, 22.0, 22.5, 23.0, 23.5, 24.0, 24.5, 25.0, 25.5, 26.0,
         25.5, 25.0, 24.5, 24.0, 23.5, 23.0, 22.5, 22.0, 21.5, 21.0, 20.5, 20.0, 19.5, 19.0, 18.5, 18.0};
 
-    for (const auto& t : temperatures)
-        device.on_temperature_change(t);
+    device.on_temperature_changes(temperatures);
 }
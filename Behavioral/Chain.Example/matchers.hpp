@@ -0,0 +1,278 @@
+#ifndef MATCHERS_HPP_
+#define MATCHERS_HPP_
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+using Temperature = double;
+
+namespace Matchers
+{
+    // Contiguous range of temperatures with open or closed bounds. Infinite bounds are closed -
+    // e.g. Gt(25.0) matches +inf as the comparison does.
+    struct Interval
+    {
+        Temperature low = -std::numeric_limits<Temperature>::infinity();
+        Temperature high = std::numeric_limits<Temperature>::infinity();
+        bool low_closed = true;
+        bool high_closed = true;
+
+        // NaN is never contained
+        bool contains(Temperature temperature) const
+        {
+            return (low < temperature || (low_closed && low == temperature))
+                && (temperature < high || (high_closed && temperature == high));
+        }
+
+        // also true for NaN bounds - such interval matches nothing
+        bool empty() const
+        {
+            return !(low <= high) || (low == high && !(low_closed && high_closed));
+        }
+
+        // The same set of temperatures with closed bounds (open ones moved to the adjacent double),
+        // so contains() becomes two comparisons. Empty interval becomes [inf, -inf].
+        Interval closure() const
+        {
+            constexpr auto inf = std::numeric_limits<Temperature>::infinity();
+
+            if (empty())
+                return Interval{inf, -inf, true, true};
+
+            return Interval{low_closed ? low : std::nextafter(low, inf), high_closed ? high : std::nextafter(high, -inf), true, true};
+        }
+
+        Interval intersect(const Interval& other) const
+        {
+            Interval result = *this;
+
+            if (other.low > low || (other.low == low && !other.low_closed))
+            {
+                result.low = other.low;
+                result.low_closed = other.low_closed;
+            }
+
+            if (other.high < high || (other.high == high && !other.high_closed))
+            {
+                result.high = other.high;
+                result.high_closed = other.high_closed;
+            }
+
+            return result;
+        }
+    };
+
+    // Predicate matching an interval - exposes it, so a Device can index its handlers
+    class IntervalMatcher
+    {
+        Interval interval_;
+
+    public:
+        explicit IntervalMatcher(const Interval& interval)
+            : interval_{interval}
+        {
+        }
+
+        bool operator()(Temperature temperature) const
+        {
+            return interval_.contains(temperature);
+        }
+
+        const Interval& interval() const
+        {
+            return interval_;
+        }
+    };
+
+    // Matches everything (NaN too) - the whole real line as far as indexing is concerned
+    struct AnyMatcher
+    {
+        bool operator()(Temperature) const
+        {
+            return true;
+        }
+
+        Interval interval() const
+        {
+            return Interval{};
+        }
+    };
+
+    // Matchers composed by And, Or and Not - plain types, so a whole expression can be inlined
+    template <typename TLhs, typename TRhs>
+    class AndMatcher
+    {
+        TLhs lhs_;
+        TRhs rhs_;
+
+    public:
+        AndMatcher(TLhs lhs, TRhs rhs)
+            : lhs_{std::move(lhs)}
+            , rhs_{std::move(rhs)}
+        {
+        }
+
+        bool operator()(Temperature temperature) const
+        {
+            return lhs_(temperature) && rhs_(temperature);
+        }
+    };
+
+    template <typename TLhs, typename TRhs>
+    class OrMatcher
+    {
+        TLhs lhs_;
+        TRhs rhs_;
+
+    public:
+        OrMatcher(TLhs lhs, TRhs rhs)
+            : lhs_{std::move(lhs)}
+            , rhs_{std::move(rhs)}
+        {
+        }
+
+        bool operator()(Temperature temperature) const
+        {
+            return lhs_(temperature) || rhs_(temperature);
+        }
+    };
+
+    template <typename TPredicate>
+    class NotMatcher
+    {
+        TPredicate pred_;
+
+    public:
+        explicit NotMatcher(TPredicate pred)
+            : pred_{std::move(pred)}
+        {
+        }
+
+        bool operator()(Temperature temperature) const
+        {
+            return !pred_(temperature);
+        }
+    };
+
+    template <typename TMatcher, typename = void>
+    struct HasInterval : std::false_type
+    {
+    };
+
+    template <typename TMatcher>
+    struct HasInterval<TMatcher, std::void_t<decltype(std::declval<const TMatcher&>().interval())>> : std::true_type
+    {
+    };
+
+    template <typename TMatcher>
+    constexpr bool has_interval_v = HasInterval<std::decay_t<TMatcher>>::value;
+
+    // Types the &&, || and ! operators compose - matchers, not arbitrary callables
+    template <typename TMatcher>
+    struct IsMatcher : std::false_type
+    {
+    };
+
+    template <>
+    struct IsMatcher<IntervalMatcher> : std::true_type
+    {
+    };
+
+    template <>
+    struct IsMatcher<AnyMatcher> : std::true_type
+    {
+    };
+
+    template <typename TLhs, typename TRhs>
+    struct IsMatcher<AndMatcher<TLhs, TRhs>> : std::true_type
+    {
+    };
+
+    template <typename TLhs, typename TRhs>
+    struct IsMatcher<OrMatcher<TLhs, TRhs>> : std::true_type
+    {
+    };
+
+    template <typename TPredicate>
+    struct IsMatcher<NotMatcher<TPredicate>> : std::true_type
+    {
+    };
+
+    template <typename TMatcher>
+    constexpr bool is_matcher_v = IsMatcher<std::decay_t<TMatcher>>::value;
+
+    template <typename Compare>
+    struct Comparer
+    {
+        // value compared with temperature - e.g. Lt(19.0) matches values < 19.0
+        IntervalMatcher operator()(Temperature temperature) const
+        {
+            constexpr auto inf = std::numeric_limits<Temperature>::infinity();
+
+            if constexpr (std::is_same_v<Compare, std::less<>>)
+                return IntervalMatcher{Interval{-inf, temperature, true, false}};
+            else if constexpr (std::is_same_v<Compare, std::less_equal<>>)
+                return IntervalMatcher{Interval{-inf, temperature, true, true}};
+            else if constexpr (std::is_same_v<Compare, std::greater<>>)
+                return IntervalMatcher{Interval{temperature, inf, false, true}};
+            else if constexpr (std::is_same_v<Compare, std::greater_equal<>>)
+                return IntervalMatcher{Interval{temperature, inf, true, true}};
+            else
+            {
+                static_assert(std::is_same_v<Compare, std::equal_to<>>, "Unsupported comparison");
+                return IntervalMatcher{Interval{temperature, temperature, true, true}};
+            }
+        }
+    };
+
+    inline const AnyMatcher _{};
+    // inline auto Lt = [](Temperature value) { return [value](Temperature temperature) { return temperature < value; }; };
+    inline const Comparer<std::less<>> Lt{};
+    inline const Comparer<std::less_equal<>> Le{};
+    inline const Comparer<std::greater<>> Gt{};
+    inline const Comparer<std::greater_equal<>> Ge{};
+    inline const Comparer<std::equal_to<>> Eq{};
+
+    // And of two interval matchers is an interval again; anything else is an opaque predicate
+    inline const auto And = [](auto&& lhs, auto&& rhs) {
+        using Lhs = std::decay_t<decltype(lhs)>;
+        using Rhs = std::decay_t<decltype(rhs)>;
+
+        if constexpr (has_interval_v<Lhs> && has_interval_v<Rhs>)
+            return IntervalMatcher{lhs.interval().intersect(rhs.interval())};
+        else
+            return AndMatcher<Lhs, Rhs>{std::forward<decltype(lhs)>(lhs), std::forward<decltype(rhs)>(rhs)};
+    };
+
+    inline const auto Or = [](auto&& lhs, auto&& rhs) {
+        return OrMatcher<std::decay_t<decltype(lhs)>, std::decay_t<decltype(rhs)>>{std::forward<decltype(lhs)>(lhs), std::forward<decltype(rhs)>(rhs)};
+    };
+
+    inline const auto Not = [](auto&& pred) {
+        return NotMatcher<std::decay_t<decltype(pred)>>{std::forward<decltype(pred)>(pred)};
+    };
+
+    // Ge(20.0) && Lt(25.0) || !Eq(0.0) - the same as And, Or and Not
+    template <typename TLhs, typename TRhs, typename = std::enable_if_t<is_matcher_v<TLhs> && is_matcher_v<TRhs>>>
+    auto operator&&(TLhs&& lhs, TRhs&& rhs)
+    {
+        return And(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs));
+    }
+
+    template <typename TLhs, typename TRhs, typename = std::enable_if_t<is_matcher_v<TLhs> && is_matcher_v<TRhs>>>
+    auto operator||(TLhs&& lhs, TRhs&& rhs)
+    {
+        return Or(std::forward<TLhs>(lhs), std::forward<TRhs>(rhs));
+    }
+
+    template <typename TPredicate, typename = std::enable_if_t<is_matcher_v<TPredicate>>>
+    auto operator!(TPredicate&& pred)
+    {
+        return Not(std::forward<TPredicate>(pred));
+    }
+} // namespace Matchers
+
+#endif /*MATCHERS_HPP_*/
@@ -0,0 +1,105 @@
+#ifndef MPSC_QUEUE_HPP_
+#define MPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Bounded lock-free queue for many producers and a single consumer (D. Vyukov's array queue).
+// Producers claim a cell with a CAS on the enqueue position, every cell carries a sequence
+// number telling whether it is free or filled. The consumer needs no CAS.
+template <typename T>
+class MpscQueue
+{
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> buffer_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos_{0}; // written by the consumer only
+
+public:
+    // capacity is rounded up to a power of two
+    explicit MpscQueue(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+
+        buffer_ = std::make_unique<Cell[]>(size);
+        mask_ = size - 1;
+        for (std::size_t i = 0; i < size; ++i)
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    // Any thread; false if the queue is full
+    bool try_push(const T& value)
+    {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &buffer_[pos & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only; false if the queue is empty
+    bool try_pop(T& value)
+    {
+        const std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell& cell = buffer_[pos & mask_];
+
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+            return false;
+
+        value = std::move(cell.data);
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate when called concurrently with push or pop
+    std::size_t size() const
+    {
+        const std::size_t dequeued = dequeue_pos_.load();
+        const std::size_t enqueued = enqueue_pos_.load();
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+};
+
+#endif /*MPSC_QUEUE_HPP_*/
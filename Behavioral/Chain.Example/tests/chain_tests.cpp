@@ -0,0 +1,44 @@
+#include "chain.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+TEST_CASE("Device dispatches from the last added handler", "[chain]")
+{
+    Device device{"test"};
+    std::vector<std::string> log;
+
+    device.add_handler([](Temperature t) { return t < 20.0; }, [&](Temperature) { log.push_back("cold"); });
+    device.add_handler([](Temperature t) { return t >= 20.0; }, [&](Temperature) { log.push_back("warm"); });
+    device.add_handler([](Temperature) { return true; }, [&](Temperature t) { log.push_back(std::to_string(static_cast<int>(t))); });
+
+    REQUIRE(device.handler_count() == 3);
+
+    device.on_temperature_change(18.0);
+    device.on_temperature_change(25.0);
+
+    REQUIRE(log == std::vector<std::string>{"18", "cold", "25", "warm"});
+}
+
+TEST_CASE("Device without handlers ignores events", "[chain]")
+{
+    Device device{"empty"};
+    REQUIRE(device.id() == "empty");
+    REQUIRE(device.handler_count() == 0);
+
+    device.on_temperature_change(20.0);
+}
+
+TEST_CASE("Device handles long chains", "[chain]")
+{
+    Device device{"long"};
+    std::vector<int> calls;
+
+    for (int i = 0; i < 10'000; ++i)
+        device.add_handler([i](Temperature t) { return t > i; }, [&calls, i](Temperature) { calls.push_back(i); });
+
+    device.on_temperature_change(2.5);
+
+    REQUIRE(calls == std::vector{2, 1, 0});
+}
@@ -0,0 +1,129 @@
+#include "device_router.hpp"
+#include "matchers.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("DeviceRouter dispatches readings to their devices", "[router]")
+{
+    DeviceRouter router{RouterOptions{3, 16}};
+    std::vector<std::vector<Temperature>> readings(10);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        const DeviceKey key = router.add_device("device-" + std::to_string(i));
+        REQUIRE(key == static_cast<DeviceKey>(i));
+        router.device(key).add_handler(Matchers::_, [&readings, i](Temperature t) { readings[i].push_back(t); });
+    }
+
+    REQUIRE(router.device_count() == 10);
+    REQUIRE(router.find("device-7") == DeviceKey{7});
+    REQUIRE_FALSE(router.find("device-10").has_value());
+    REQUIRE(router.device(7).id() == "device-7");
+
+    router.start();
+    for (int n = 0; n < 100; ++n) // more than fits into the queues
+        for (DeviceKey key = 0; key < 10; ++key)
+            router.post(key, key * 1000.0 + n);
+    router.stop();
+
+    REQUIRE(router.dispatched() == 1000);
+    REQUIRE(router.latency().count == 1000);
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(readings[i].size() == 100);
+        for (int n = 0; n < 100; ++n)
+            REQUIRE(readings[i][n] == i * 1000.0 + n);
+    }
+}
+
+TEST_CASE("DeviceRouter keeps the order of readings of every producer", "[router]")
+{
+    constexpr int producer_count = 4;
+    constexpr int devices_per_producer = 50;
+    constexpr int readings_per_device = 500;
+
+    DeviceRouter router{RouterOptions{3, 64, false}};
+    std::vector<std::vector<Temperature>> readings(producer_count * devices_per_producer);
+
+    for (std::size_t i = 0; i < readings.size(); ++i)
+    {
+        const DeviceKey key = router.add_device(std::to_string(i));
+        router.device(key).add_handler(Matchers::_, [&readings, key](Temperature t) { readings[key].push_back(t); });
+    }
+
+    router.start();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; ++p)
+    {
+        producers.emplace_back([&router, p] {
+            for (int n = 0; n < readings_per_device; ++n)
+                for (int d = 0; d < devices_per_producer; ++d)
+                    router.post(static_cast<DeviceKey>(p * devices_per_producer + d), n);
+        });
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+    router.stop();
+
+    REQUIRE(router.dispatched() == readings.size() * readings_per_device);
+    for (const auto& device_readings : readings)
+    {
+        REQUIRE(device_readings.size() == readings_per_device);
+        for (int n = 0; n < readings_per_device; ++n)
+            REQUIRE(device_readings[n] == n);
+    }
+}
+
+TEST_CASE("DeviceRouter rejects unknown and duplicate devices", "[router]")
+{
+    DeviceRouter router{RouterOptions{2, 8}};
+    router.add_device("a");
+
+    REQUIRE_THROWS_AS(router.add_device("a"), std::invalid_argument);
+    REQUIRE_THROWS_AS(router.post(1, 20.0), std::out_of_range);
+    REQUIRE_THROWS_AS(router.device(1), std::out_of_range);
+
+    router.start();
+    REQUIRE_THROWS_AS(router.add_device("b"), std::logic_error);
+}
+
+TEST_CASE("DeviceRouter accepts readings only while running", "[router]")
+{
+    DeviceRouter router{RouterOptions{2, 8}};
+    const DeviceKey key = router.add_device("a");
+
+    REQUIRE_THROWS_AS(router.post(key, 20.0), std::logic_error);
+
+    router.start();
+    for (int i = 0; i < 100; ++i) // more than the queue capacity
+        router.post(key, 20.0);
+    router.stop();
+
+    REQUIRE(router.dispatched() == 100);
+    REQUIRE_THROWS_AS(router.post(key, 20.0), std::logic_error);
+}
+
+TEST_CASE("LatencyHistogram percentiles", "[router]")
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i)
+        histogram.record(std::chrono::nanoseconds{100});
+    histogram.record(std::chrono::nanoseconds{5'000});
+
+    REQUIRE(histogram.count == 100);
+    REQUIRE(histogram.percentile(0.5) == std::chrono::nanoseconds{128});
+    REQUIRE(histogram.percentile(0.99) == std::chrono::nanoseconds{128});
+    REQUIRE(histogram.percentile(1.0) == std::chrono::nanoseconds{5'000});
+
+    LatencyHistogram other;
+    other.record(std::chrono::nanoseconds{10'000});
+    histogram.merge(other);
+    REQUIRE(histogram.count == 101);
+    REQUIRE(histogram.max == std::chrono::nanoseconds{10'000});
+}
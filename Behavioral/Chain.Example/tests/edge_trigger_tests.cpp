@@ -0,0 +1,109 @@
+#include "chain.hpp"
+#include "matchers.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Matchers;
+
+TEST_CASE("Edge-triggered handler is called when its predicate becomes true", "[chain][edge]")
+{
+    Device device{"edge"};
+    std::vector<std::string> log;
+
+    device.add_handler(Lt(19.0), [&](Temperature) { log.push_back("heater on"); }, Trigger::edge);
+    device.add_handler([](Temperature t) { return t >= 21.0; }, [&](Temperature) { log.push_back("heater off"); }, Trigger::edge);
+    device.add_handler(_, [&](Temperature) { log.push_back("reading"); });
+
+    for (const Temperature t : {18.0, 18.5, 18.0, 20.0, 21.0, 22.0, 18.0, 17.0})
+        device.on_temperature_change(t);
+
+    REQUIRE(log == std::vector<std::string>{"reading", "heater on", "reading", "reading", "reading", "reading", "heater off", "reading",
+                       "reading", "heater on", "reading"});
+}
+
+TEST_CASE("Edge-triggered handlers in batches match the readings one by one", "[chain][edge]")
+{
+    constexpr auto not_a_number = std::numeric_limits<Temperature>::quiet_NaN();
+
+    std::mt19937 gen{4};
+    std::uniform_int_distribution<int> kind{0, 3};
+    std::uniform_int_distribution<int> bound{15, 30};
+
+    std::vector<Temperature> temperatures;
+    std::normal_distribution<Temperature> step{0.0, 0.3};
+    Temperature t = 22.0;
+    for (int i = 0; i < 1'000; ++i)
+    {
+        t += step(gen);
+        temperatures.push_back(i % 97 == 0 ? not_a_number : t);
+    }
+
+    std::vector<std::function<bool(Temperature)>> predicates;
+    std::vector<Trigger> triggers;
+    std::vector<std::pair<int, Temperature>> single_calls, batch_calls;
+    Device single{"single"};
+    Device batch{"batch"};
+
+    auto add = [&](auto matcher) {
+        const int id = static_cast<int>(predicates.size());
+        const Trigger trigger = id % 3 == 0 ? Trigger::level : Trigger::edge;
+        predicates.emplace_back(matcher);
+        triggers.push_back(trigger);
+        single.add_handler(matcher, [&single_calls, id](Temperature t) { single_calls.emplace_back(id, t); }, trigger);
+        batch.add_handler(matcher, [&batch_calls, id](Temperature t) { batch_calls.emplace_back(id, t); }, trigger);
+    };
+
+    for (int i = 0; i < 60; ++i)
+    {
+        const Temperature a = bound(gen);
+        switch (kind(gen))
+        {
+        case 0:
+            add(Lt(a));
+            break;
+        case 1:
+            add(And(Ge(a), Lt(a + 2.0)));
+            break;
+        case 2:
+            add(_);
+            break;
+        default:
+            add(Not(And(Ge(a), Lt(a + 1.0))));
+            break;
+        }
+    }
+
+    // each predicate and its result for the previous reading
+    std::vector<std::pair<int, Temperature>> expected;
+    std::vector<bool> accepted(predicates.size(), false);
+    for (const Temperature t : temperatures)
+    {
+        for (int id = static_cast<int>(predicates.size()) - 1; id >= 0; --id)
+        {
+            const bool accepts = predicates[id](t);
+            if (accepts && (triggers[id] == Trigger::level || !accepted[id]))
+                expected.emplace_back(id, t);
+            accepted[id] = accepts;
+        }
+    }
+
+    for (const Temperature t : temperatures)
+        single.on_temperature_change(t);
+    batch.on_temperature_changes(temperatures);
+
+    auto ids = [](const std::vector<std::pair<int, Temperature>>& calls) {
+        std::vector<int> result;
+        for (const auto& call : calls)
+            result.push_back(call.first);
+        return result;
+    };
+
+    REQUIRE(ids(single_calls) == ids(expected));
+    REQUIRE(ids(batch_calls) == ids(expected));
+}
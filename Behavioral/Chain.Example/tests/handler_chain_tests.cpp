@@ -0,0 +1,68 @@
+#include "chain.hpp"
+#include "handler_chain.hpp"
+#include "matchers.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Matchers;
+
+TEST_CASE("Composed matchers evaluate like the comparisons", "[matchers]")
+{
+    const auto comfortable = Or(And(Ge(20.0), Lt(25.0)), Not(Gt(0.0)));
+    const auto comfortable_operators = (Ge(20.0) && Lt(25.0)) || !Gt(0.0);
+    const auto with_lambda = And(Not(Eq(22.0)), [](Temperature t) { return t < 30.0; });
+
+    const std::vector<Temperature> samples{-std::numeric_limits<Temperature>::infinity(), -1.0, 0.0, 10.0, 20.0, 22.0, 24.5, 25.0, 30.0,
+        std::numeric_limits<Temperature>::quiet_NaN()};
+
+    for (const Temperature t : samples)
+    {
+        const bool expected = (t >= 20.0 && t < 25.0) || !(t > 0.0);
+        REQUIRE(comfortable(t) == expected);
+        REQUIRE(comfortable_operators(t) == expected);
+        REQUIRE(with_lambda(t) == (!(t == 22.0) && t < 30.0));
+    }
+
+    STATIC_REQUIRE(std::is_same_v<decltype(Ge(20.0) && Lt(25.0)), IntervalMatcher>);
+    STATIC_REQUIRE(is_matcher_v<decltype(comfortable)>);
+    STATIC_REQUIRE_FALSE(has_interval_v<decltype(comfortable)>);
+}
+
+TEST_CASE("HandlerChain calls matching handlers in the listed order", "[handler_chain]")
+{
+    std::vector<std::string> log;
+
+    auto chain = make_handler_chain(
+        make_handler(_, [&log](Temperature) { log.push_back("reading"); }),
+        make_handler(Lt(19.0), [&log](Temperature) { log.push_back("cold"); }),
+        make_handler(Ge(22.5) && Lt(25.0), [&log](Temperature) { log.push_back("warm"); }),
+        make_handler(Ge(25.0) || Eq(-1.0), [&log](Temperature) { log.push_back("hot"); }));
+
+    STATIC_REQUIRE(decltype(chain)::size() == 4);
+
+    for (const Temperature t : {18.0, 23.0, 30.0, 20.0})
+        chain.on_temperature_change(t);
+
+    REQUIRE(log == std::vector<std::string>{"reading", "cold", "reading", "warm", "reading", "hot", "reading"});
+}
+
+TEST_CASE("HandlerChain is a single handler of a Device", "[handler_chain]")
+{
+    std::vector<std::string> log;
+    Device device{"static"};
+
+    device.add_handler(_, make_handler_chain(make_handler(Lt(19.0), [&log](Temperature) { log.push_back("cold"); }),
+                              make_handler(Not(Lt(19.0)), [&log](Temperature) { log.push_back("not cold"); })));
+    device.add_handler(Ge(30.0), [&log](Temperature) { log.push_back("alarm"); });
+
+    REQUIRE(device.handler_count() == 2);
+
+    device.on_temperature_change(18.0);
+    device.on_temperature_change(35.0);
+
+    REQUIRE(log == std::vector<std::string>{"cold", "alarm", "not cold"});
+}
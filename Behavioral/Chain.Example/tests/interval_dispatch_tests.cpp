@@ -0,0 +1,300 @@
+#include "chain.hpp"
+#include "interval_index.hpp"
+#include "matchers.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Matchers;
+
+namespace
+{
+    constexpr auto inf = std::numeric_limits<Temperature>::infinity();
+    constexpr auto not_a_number = std::numeric_limits<Temperature>::quiet_NaN();
+}
+
+TEST_CASE("Comparers expose intervals matching the comparison", "[matchers]")
+{
+    const std::vector<Temperature> samples{-inf, 18.0, 19.0, 19.5, 20.0, inf, not_a_number};
+
+    for (const Temperature t : samples)
+    {
+        REQUIRE(Lt(19.0)(t) == (t < 19.0));
+        REQUIRE(Le(19.0)(t) == (t <= 19.0));
+        REQUIRE(Gt(19.0)(t) == (t > 19.0));
+        REQUIRE(Ge(19.0)(t) == (t >= 19.0));
+        REQUIRE(Eq(19.0)(t) == (t == 19.0));
+        REQUIRE(And(Ge(19.0), Lt(20.0))(t) == (t >= 19.0 && t < 20.0));
+        REQUIRE(_(t));
+    }
+
+    STATIC_REQUIRE(has_interval_v<decltype(Lt(1.0))>);
+    STATIC_REQUIRE(has_interval_v<decltype(And(Ge(1.0), Lt(2.0)))>);
+    STATIC_REQUIRE(has_interval_v<decltype(_)>);
+    STATIC_REQUIRE_FALSE(has_interval_v<decltype(Or(Lt(1.0), Gt(2.0)))>);
+    STATIC_REQUIRE_FALSE(has_interval_v<decltype(Not(Lt(1.0)))>);
+}
+
+TEST_CASE("Interval intersection", "[matchers]")
+{
+    REQUIRE(And(Gt(20.0), Lt(20.0)).interval().empty());
+    REQUIRE(And(Ge(20.0), Lt(20.0)).interval().empty());
+    REQUIRE_FALSE(And(Ge(20.0), Le(20.0)).interval().empty());
+    REQUIRE(And(Ge(20.0), Le(20.0))(20.0));
+
+    const auto open = And(Gt(20.0), Ge(20.0)).interval();
+    REQUIRE(open.low == 20.0);
+    REQUIRE_FALSE(open.low_closed);
+}
+
+TEST_CASE("IntervalIndex finds all intervals containing a point", "[interval_index]")
+{
+    std::mt19937 gen{1};
+    std::uniform_real_distribution<Temperature> bound{0.0, 100.0};
+    std::uniform_int_distribution<int> closed{0, 1};
+
+    for (const std::size_t n : {1u, 2u, 3u, 7u, 8u, 9u, 31u, 100u, 1000u})
+    {
+        std::vector<Interval> intervals;
+        IntervalIndex index;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Temperature a = std::round(bound(gen)), b = std::round(bound(gen));
+            intervals.push_back(Interval{std::min(a, b), std::max(a, b), closed(gen) == 1, closed(gen) == 1});
+            index.add(intervals.back(), i);
+        }
+        index.build();
+
+        for (Temperature t = -1.0; t <= 101.0; t += 0.5)
+        {
+            std::vector<std::size_t> expected;
+            for (std::size_t i = 0; i < n; ++i)
+                if (intervals[i].contains(t))
+                    expected.push_back(i);
+
+            std::vector<std::size_t> found;
+            index.find(t, [&found](std::size_t value) { found.push_back(value); });
+            std::sort(found.begin(), found.end());
+
+            REQUIRE(found == expected);
+        }
+    }
+}
+
+TEST_CASE("Indexed dispatch calls the same handlers in the same order as the chain", "[chain]")
+{
+    std::mt19937 gen{2};
+    std::uniform_int_distribution<int> kind{0, 6};
+    std::uniform_int_distribution<int> bound{0, 40};
+
+    Device device{"mixed"};
+    std::vector<std::function<bool(Temperature)>> predicates;
+    std::vector<int> calls;
+
+    auto add = [&](auto matcher) {
+        const int id = static_cast<int>(predicates.size());
+        predicates.emplace_back(matcher);
+        device.add_handler(matcher, [&calls, id](Temperature) { calls.push_back(id); });
+    };
+
+    for (int i = 0; i < 500; ++i)
+    {
+        const Temperature a = bound(gen), b = bound(gen);
+        switch (kind(gen))
+        {
+        case 0:
+            add(Lt(a));
+            break;
+        case 1:
+            add(Ge(a));
+            break;
+        case 2:
+            add(And(Gt(a), Le(b)));
+            break;
+        case 3:
+            add(Eq(a));
+            break;
+        case 4:
+            add(_);
+            break;
+        case 5:
+            add(Or(Lt(a), Gt(b)));
+            break;
+        default:
+            add([a](Temperature t) { return t != a; });
+            break;
+        }
+    }
+
+    std::vector<Temperature> temperatures{-inf, inf, not_a_number};
+    for (Temperature t = -1.0; t <= 41.0; t += 0.5)
+        temperatures.push_back(t);
+
+    for (const Temperature t : temperatures)
+    {
+        std::vector<int> expected;
+        for (int id = static_cast<int>(predicates.size()) - 1; id >= 0; --id)
+            if (predicates[id](t))
+                expected.push_back(id);
+
+        calls.clear();
+        device.on_temperature_change(t);
+
+        REQUIRE(calls == expected);
+    }
+}
+
+TEST_CASE("Handlers added after dispatch are indexed", "[chain]")
+{
+    Device device{"late"};
+    std::vector<int> calls;
+
+    device.add_handler(Lt(20.0), [&](Temperature) { calls.push_back(1); });
+    device.on_temperature_change(10.0);
+
+    device.add_handler(Lt(15.0), [&](Temperature) { calls.push_back(2); });
+    device.on_temperature_change(10.0);
+
+    REQUIRE(calls == std::vector{1, 2, 1});
+}
+
+TEST_CASE("Handler may send a nested event to its device", "[chain]")
+{
+    Device device{"nested"};
+    std::vector<Temperature> calls;
+
+    device.add_handler(Ge(0.0), [&](Temperature t) { calls.push_back(t); });
+    device.add_handler(Ge(30.0), [&](Temperature t) {
+        calls.push_back(-t);
+        device.on_temperature_change(t - 20.0);
+    });
+
+    device.on_temperature_change(35.0);
+
+    REQUIRE(calls == std::vector<Temperature>{-35.0, 15.0, 35.0});
+}
+
+TEST_CASE("Interval closure has the same temperatures", "[matchers]")
+{
+    const std::vector<Interval> intervals{Interval{}, Lt(20.0).interval(), Gt(20.0).interval(), And(Gt(-inf), Lt(inf)).interval(),
+        And(Gt(20.0), Lt(20.0)).interval(), Interval{inf, inf, false, true}, Interval{not_a_number, 1.0, true, true}};
+    const std::vector<Temperature> samples{-inf, std::nextafter(20.0, -inf), 20.0, std::nextafter(20.0, inf), inf, not_a_number};
+
+    for (const auto& interval : intervals)
+    {
+        const Interval closure = interval.closure();
+        for (const Temperature t : samples)
+            REQUIRE((closure.low <= t && t <= closure.high) == interval.contains(t));
+    }
+}
+
+TEST_CASE("Batch dispatch calls the same handlers as dispatching readings one by one", "[chain]")
+{
+    std::mt19937 gen{3};
+    std::uniform_int_distribution<int> kind{0, 4};
+    std::uniform_int_distribution<int> bound{0, 40};
+
+    // random readings and a slowly changing sensor
+    std::vector<Temperature> temperatures{-inf, inf, not_a_number};
+    std::uniform_int_distribution<int> half_degrees{-2, 82};
+    for (int i = 0; i < 200; ++i)
+        temperatures.push_back(half_degrees(gen) / 2.0);
+    for (int i = 0; i < 300; ++i) // not a multiple of the chunk size
+        temperatures.push_back(i % 50 == 0 ? not_a_number : 20.0 + (i % 40) * 0.125);
+
+    for (const int handler_count : {5, 50, 500})
+    {
+        std::vector<std::pair<int, Temperature>> single_calls, batch_calls;
+        Device single{"single"};
+        Device batch{"batch"};
+
+        auto add = [&](auto matcher) {
+            const int id = static_cast<int>(single.handler_count());
+            single.add_handler(matcher, [&single_calls, id](Temperature t) { single_calls.emplace_back(id, t); });
+            batch.add_handler(matcher, [&batch_calls, id](Temperature t) { batch_calls.emplace_back(id, t); });
+        };
+
+        for (int i = 0; i < handler_count; ++i)
+        {
+            const Temperature a = bound(gen), b = bound(gen);
+            switch (kind(gen))
+            {
+            case 0:
+                add(Lt(a));
+                break;
+            case 1:
+                add(And(Ge(a), Lt(b)));
+                break;
+            case 2:
+                add(Eq(a));
+                break;
+            case 3:
+                add(_);
+                break;
+            default:
+                add(Not(Eq(a)));
+                break;
+            }
+        }
+
+        for (const Temperature t : temperatures)
+            single.on_temperature_change(t);
+        batch.on_temperature_changes(temperatures);
+
+        REQUIRE(batch_calls.size() == single_calls.size());
+        for (std::size_t i = 0; i < single_calls.size(); ++i)
+        {
+            REQUIRE(batch_calls[i].first == single_calls[i].first);
+            REQUIRE((batch_calls[i].second == single_calls[i].second || (std::isnan(batch_calls[i].second) && std::isnan(single_calls[i].second))));
+        }
+    }
+}
+
+TEST_CASE("IntervalIndex finds intervals overlapping a range", "[interval_index]")
+{
+    IntervalIndex index;
+    index.add(Lt(10.0).interval(), 0);
+    index.add(And(Ge(10.0), Lt(20.0)).interval(), 1);
+    index.add(Gt(20.0).interval(), 2);
+    index.add(Eq(15.0).interval(), 3);
+    index.build();
+
+    auto find = [&index](Temperature low, Temperature high) {
+        std::vector<std::size_t> found;
+        index.find(low, high, [&found](std::size_t value) { found.push_back(value); });
+        std::sort(found.begin(), found.end());
+        return found;
+    };
+
+    REQUIRE(find(11.0, 12.0) == std::vector<std::size_t>{1});
+    REQUIRE(find(5.0, 15.0) == std::vector<std::size_t>{0, 1, 3});
+    REQUIRE(find(20.0, 20.0) == std::vector<std::size_t>{1, 2}); // touching open bounds
+    REQUIRE(find(-inf, inf) == std::vector<std::size_t>{0, 1, 2, 3});
+}
+
+TEST_CASE("Batch dispatch evaluates opaque predicates in order", "[chain]")
+{
+    Device device{"stateful"};
+    bool heating = false;
+    std::vector<std::string> log;
+
+    device.add_handler([&heating](Temperature) { return heating; }, [&](Temperature) { log.push_back("heating"); });
+    device.add_handler(Lt(19.0), [&](Temperature) {
+        heating = true;
+        log.push_back("cold");
+    });
+    device.add_handler(Ge(21.0), [&](Temperature) {
+        heating = false;
+        log.push_back("warm");
+    });
+
+    device.on_temperature_changes(std::vector{20.0, 18.0, 20.0, 22.0, 20.0});
+
+    REQUIRE(log == std::vector<std::string>{"cold", "heating", "heating", "warm"});
+}
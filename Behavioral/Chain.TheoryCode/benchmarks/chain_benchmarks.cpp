@@ -0,0 +1,148 @@
+#include "chain.hpp"
+#include "request_router.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t request_count = 10'000'000;
+    constexpr int range_width = 10;
+
+    // Handler of requests in [low, low + range_width) - every tenth passes its requests on
+    class RangeHandler : public Handler
+    {
+        int low_;
+        std::size_t& handled_;
+
+    public:
+        RangeHandler(int low, std::size_t& handled)
+            : low_{low}, handled_{handled}
+        {
+        }
+
+    protected:
+        bool can_handle(int request) override
+        {
+            return request >= low_ && request < low_ + range_width;
+        }
+
+        bool process_request(int request) override
+        {
+            ++handled_;
+            return request % 10 != 0;
+        }
+    };
+
+    // Requests hitting one of the handler_count ranges placed every stride requests, 1 in
+    // (handler_count + 1) hits none of them
+    std::vector<int> requests(int handler_count, int stride)
+    {
+        std::mt19937 generator{42};
+        std::uniform_int_distribution<int> range{0, handler_count};
+        std::uniform_int_distribution<int> offset{0, range_width - 1};
+
+        std::vector<int> result(request_count);
+        for (auto& request : result)
+            request = range(generator) * stride + offset(generator);
+        return result;
+    }
+
+    void report(benchmark::State& state, std::size_t handled)
+    {
+        state.SetItemsProcessed(state.iterations() * request_count);
+        state.counters["handled/request"] = static_cast<double>(handled) / (state.iterations() * request_count);
+    }
+} // namespace
+
+// Classic chain - walks the successors of the first handler
+static void BM_HandlerChain(benchmark::State& state)
+{
+    const int handler_count = static_cast<int>(state.range(0));
+    const auto events = requests(handler_count, range_width);
+
+    std::size_t handled = 0;
+    std::vector<std::shared_ptr<Handler>> handlers;
+    for (int i = 0; i < handler_count; ++i)
+    {
+        handlers.push_back(std::make_shared<RangeHandler>(i * range_width, handled));
+        if (i > 0)
+            handlers[i - 1]->set_successor(handlers[i]);
+    }
+
+    for (auto _ : state)
+    {
+        for (int request : events)
+            benchmark::DoNotOptimize(handlers.front()->handle_request(request));
+    }
+
+    report(state, handled);
+}
+BENCHMARK(BM_HandlerChain)->Arg(3)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
+
+// The same handlers routed by their ranges; state.range(1) is the distance of the ranges - the
+// sparse ones do not fit a table and are routed by a binary search
+static void BM_RequestRouter(benchmark::State& state)
+{
+    const int handler_count = static_cast<int>(state.range(0));
+    const int stride = static_cast<int>(state.range(1));
+    const auto events = requests(handler_count, stride);
+
+    std::size_t handled = 0;
+    RequestRouter router;
+    for (int i = 0; i < handler_count; ++i)
+    {
+        router.add_handler(i * stride, i * stride + range_width, [&handled](int request) {
+            ++handled;
+            return request % 10 != 0;
+        });
+    }
+
+    for (auto _ : state)
+    {
+        for (int request : events)
+            benchmark::DoNotOptimize(router.handle_request(request));
+    }
+
+    report(state, handled);
+}
+BENCHMARK(BM_RequestRouter)
+    ->Args({3, range_width})
+    ->Args({16, range_width})
+    ->Args({256, range_width})
+    ->Args({256, 1 << 16})
+    ->Unit(benchmark::kMillisecond);
+
+// Requests matching no range fall back to a dynamic handler
+static void BM_RequestRouter_Fallback(benchmark::State& state)
+{
+    const int handler_count = static_cast<int>(state.range(0));
+    const auto events = requests(handler_count, range_width);
+
+    std::size_t handled = 0;
+    RequestRouter router;
+    for (int i = 0; i < handler_count; ++i)
+    {
+        router.add_handler(i * range_width, i * range_width + range_width, [&handled](int request) {
+            ++handled;
+            return request % 10 != 0;
+        });
+    }
+    router.add_dynamic_handler([](int request) { return request % 2 == 0; }, [&handled](int) {
+        ++handled;
+        return true;
+    });
+
+    for (auto _ : state)
+    {
+        for (int request : events)
+            benchmark::DoNotOptimize(router.handle_request(request));
+    }
+
+    report(state, handled);
+}
+BENCHMARK(BM_RequestRouter_Fallback)->Arg(3)->Arg(256)->Unit(benchmark::kMillisecond);
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 
 // "Handler"
 class Handler
@@ -14,27 +15,26 @@ public:
 
     void set_successor(std::shared_ptr<Handler> successor)
     {
-        successor_ = successor;
+        successor_ = std::move(successor);
     }
 
-    void handle_request(int request)
+    // Passes the request along the chain until a handler accepts it - returns false if none did
+    bool handle_request(int request)
     {
-        bool is_accepted = false;
+        for (Handler* handler = this; handler != nullptr; handler = handler->successor_.get())
+        {
+            if (handler->can_handle(request) && handler->process_request(request))
+                return true;
+        }
 
-        if (can_handle(request))
-            process_request(request, is_accepted);
-
-        if (is_accepted)
-            return;
-
-        if (successor_ != nullptr)
-            successor_->handle_request(request);
+        return false;
     }
 
     virtual ~Handler() = default;
 protected:
     virtual bool can_handle(int request) = 0;
-    virtual void process_request(int request, bool& is_accepted) = 0;
+    // true - the request is accepted and not passed to the successors
+    virtual bool process_request(int request) = 0;
 };
 
 // "ConcreteHandler1"
@@ -46,9 +46,11 @@ protected:
         return (request >= 0) && (request < 10);
     }
 
-    void process_request(int request, bool& is_accepted) override
+    bool process_request(int request) override
     {
         std::cout << "ConcreteHandler1 handled request " << request << std::endl;
+
+        return false;
     }
 };
 
@@ -61,11 +63,11 @@ protected:
         return (request >= 10) && (request < 20);
     }
 
-    void process_request(int request, bool& is_accepted) override
+    bool process_request(int request) override
     {
         std::cout << "ConcreteHandler2 handled request " << request << std::endl;
 
-        is_accepted = true;
+        return true;
     }
 };
 
@@ -78,9 +80,11 @@ protected:
         return (request >= 20) && (request < 30);
     }
 
-    void process_request(int request, bool& is_accepted) override
+    bool process_request(int request) override
     {
         std::cout << "ConcreteHandler3 handled request " << request << std::endl;
+
+        return false;
     }
 };
 
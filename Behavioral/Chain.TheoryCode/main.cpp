@@ -1,4 +1,5 @@
 #include "chain.hpp"
+#include "request_router.hpp"
 #include <array>
 #include <iostream>
 
@@ -20,4 +21,23 @@ int main()
     {
         h1->handle_request(r);
     }
+
+    cout << "\n";
+
+    // The same chain routed by the ranges of requests - like ConcreteHandler1 and ConcreteHandler3
+    // the handlers of [0, 10) and [20, 30) pass requests on, a dynamic handler is the fallback
+    RequestRouter router;
+    router.add_handler(0, 10, [](int request) { cout << "Range [0, 10) handled request " << request << endl; return false; });
+    router.add_handler(10, 20, [](int request) { cout << "Range [10, 20) handled request " << request << endl; return true; });
+    router.add_handler(20, 30, [](int request) { cout << "Range [20, 30) handled request " << request << endl; return false; });
+    router.add_dynamic_handler([](int request) { return request % 2 == 0; },
+        [](int request) { cout << "Even requests handler handled request " << request << endl; return true; });
+
+    array<int, 10> router_requests = {2, 5, 14, 22, 18, 3, 27, 20, 42, 43};
+
+    for (const auto& r : router_requests)
+    {
+        if (!router.handle_request(r))
+            cout << "Request " << r << " not handled" << endl;
+    }
 }
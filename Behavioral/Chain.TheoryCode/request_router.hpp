@@ -0,0 +1,200 @@
+#ifndef REQUEST_ROUTER_HPP_
+#define REQUEST_ROUTER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Chain of responsibility for integer requests, routed by a lookup instead of a walk.
+//
+// Ranged handlers declare up front the range [low, high) of requests they accept, so the chain
+// of candidates for a request is known before it arrives: the ranges cut the line into segments,
+// every segment gets its list of handlers (a route) and a table maps a request to its route.
+// Handlers deciding only at runtime (dynamic ones) form a fallback chain.
+//
+// Priority: ranged handlers covering the request are called in the order they were added, then
+// the dynamic ones, again in order. The first handler returning true accepts the request and
+// routing stops - as in Handler::handle_request.
+// Unlike a plain chain, where the order of links alone sets the priority, dynamic handlers always
+// run after the ranged ones - even a dynamic handler added before a ranged one.
+class RequestRouter
+{
+public:
+    using Request = int;
+    using RequestHandler = std::function<bool(Request)>; // true - accepted
+    using CanHandle = std::function<bool(Request)>;
+
+    // Spans of ranges up to this size are routed by a direct table, larger ones by a binary search
+    static constexpr std::size_t max_table_size = std::size_t{1} << 20;
+
+private:
+    struct RangedHandler
+    {
+        std::int64_t low;
+        std::int64_t high;
+        RequestHandler handler;
+    };
+
+    struct DynamicHandler
+    {
+        CanHandle can_handle;
+        RequestHandler handler;
+    };
+
+    struct Route
+    {
+        std::uint32_t first; // into route_handlers_
+        std::uint32_t count;
+    };
+
+    std::vector<RangedHandler> ranged_;
+    std::vector<DynamicHandler> dynamic_;
+
+    // built lazily by the first request after a handler is added
+    std::vector<std::uint32_t> route_handlers_; // indexes into ranged_, routes stored back to back
+    std::vector<Route> routes_;                 // routes_[0] is the empty route
+    std::vector<std::int64_t> boundaries_;      // segment i is [boundaries_[i], boundaries_[i + 1])
+    std::vector<std::uint32_t> segment_routes_;
+    std::vector<std::uint32_t> table_; // route of request table_low_ + i
+    std::int64_t table_low_ = 0;
+    bool built_ = false;
+
+public:
+    // Handler of requests in [low, high)
+    void add_handler(Request low, Request high, RequestHandler handler)
+    {
+        if (high < low)
+            throw std::invalid_argument{"Range of requests must not end before it starts"};
+
+        ranged_.push_back(RangedHandler{low, high, std::move(handler)});
+        built_ = false;
+    }
+
+    void add_dynamic_handler(CanHandle can_handle, RequestHandler handler)
+    {
+        dynamic_.push_back(DynamicHandler{std::move(can_handle), std::move(handler)});
+    }
+
+    std::size_t handler_count() const
+    {
+        return ranged_.size() + dynamic_.size();
+    }
+
+    // Returns false if no handler accepted the request
+    bool handle_request(Request request)
+    {
+        if (!built_)
+            build();
+
+        const Route route = routes_[route_of(request)];
+        for (std::uint32_t i = route.first; i < route.first + route.count; ++i)
+        {
+            if (ranged_[route_handlers_[i]].handler(request))
+                return true;
+        }
+
+        for (auto& dynamic : dynamic_)
+        {
+            if (dynamic.can_handle(request) && dynamic.handler(request))
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    std::uint32_t route_of(Request request) const
+    {
+        if (!table_.empty())
+        {
+            const auto offset = static_cast<std::uint64_t>(request - table_low_);
+            return offset < table_.size() ? table_[offset] : 0;
+        }
+
+        if (boundaries_.empty())
+            return 0;
+
+        // last boundary <= request - branchless, the requests are usually unpredictable
+        const std::int64_t* segment = boundaries_.data();
+        for (std::size_t size = boundaries_.size(); size > 1; size -= size / 2)
+            segment = segment[size / 2] <= request ? segment + size / 2 : segment;
+
+        const auto index = static_cast<std::size_t>(segment - boundaries_.data());
+        if (*segment > request || index + 1 == boundaries_.size())
+            return 0;
+        return segment_routes_[index];
+    }
+
+    void build()
+    {
+        route_handlers_.clear();
+        routes_.assign(1, Route{0, 0});
+        boundaries_.clear();
+        segment_routes_.clear();
+        table_.clear();
+        table_low_ = 0;
+
+        std::vector<std::pair<std::int64_t, std::uint32_t>> starts, ends;
+        for (std::uint32_t i = 0; i < ranged_.size(); ++i)
+        {
+            if (ranged_[i].low == ranged_[i].high)
+                continue;
+
+            starts.emplace_back(ranged_[i].low, i);
+            ends.emplace_back(ranged_[i].high, i);
+            boundaries_.push_back(ranged_[i].low);
+            boundaries_.push_back(ranged_[i].high);
+        }
+
+        std::sort(starts.begin(), starts.end());
+        std::sort(ends.begin(), ends.end());
+        std::sort(boundaries_.begin(), boundaries_.end());
+        boundaries_.erase(std::unique(boundaries_.begin(), boundaries_.end()), boundaries_.end());
+
+        // sweep the segments keeping the handlers covering the current one - ordered by priority
+        std::set<std::uint32_t> active;
+        std::map<std::vector<std::uint32_t>, std::uint32_t> route_ids{{{}, 0}};
+        auto start = starts.begin();
+        auto end = ends.begin();
+
+        for (std::size_t segment = 0; segment + 1 < boundaries_.size(); ++segment)
+        {
+            const std::int64_t low = boundaries_[segment];
+            for (; end != ends.end() && end->first <= low; ++end)
+                active.erase(end->second);
+            for (; start != starts.end() && start->first <= low; ++start)
+                active.insert(start->second);
+
+            std::vector<std::uint32_t> handlers(active.begin(), active.end());
+            auto [it, inserted] = route_ids.emplace(std::move(handlers), static_cast<std::uint32_t>(routes_.size()));
+            if (inserted)
+            {
+                routes_.push_back(Route{static_cast<std::uint32_t>(route_handlers_.size()), static_cast<std::uint32_t>(it->first.size())});
+                route_handlers_.insert(route_handlers_.end(), it->first.begin(), it->first.end());
+            }
+            segment_routes_.push_back(it->second);
+        }
+
+        if (boundaries_.size() > 1 && static_cast<std::uint64_t>(boundaries_.back() - boundaries_.front()) <= max_table_size)
+        {
+            table_low_ = boundaries_.front();
+            table_.resize(static_cast<std::size_t>(boundaries_.back() - table_low_));
+            for (std::size_t segment = 0; segment < segment_routes_.size(); ++segment)
+            {
+                std::fill(table_.begin() + (boundaries_[segment] - table_low_), table_.begin() + (boundaries_[segment + 1] - table_low_),
+                    segment_routes_[segment]);
+            }
+        }
+
+        built_ = true;
+    }
+};
+
+#endif /*REQUEST_ROUTER_HPP_*/
@@ -0,0 +1,209 @@
+#include "chain.hpp"
+#include "request_router.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    class RecordingHandler : public Handler
+    {
+        int low_;
+        int high_;
+        bool accepts_;
+
+    public:
+        std::vector<int> requests;
+
+        RecordingHandler(int low, int high, bool accepts)
+            : low_{low}, high_{high}, accepts_{accepts}
+        {
+        }
+
+    protected:
+        bool can_handle(int request) override
+        {
+            return request >= low_ && request < high_;
+        }
+
+        bool process_request(int request) override
+        {
+            requests.push_back(request);
+            return accepts_;
+        }
+    };
+
+    // Handler recording its name in a shared log
+    RequestRouter::RequestHandler logging(std::vector<std::string>& log, std::string name, bool accepts = true)
+    {
+        return [&log, name = std::move(name), accepts](int) {
+            log.push_back(name);
+            return accepts;
+        };
+    }
+} // namespace
+
+TEST_CASE("Handler chain stops at the first handler accepting a request", "[chain]")
+{
+    auto first = std::make_shared<RecordingHandler>(0, 10, false);
+    auto second = std::make_shared<RecordingHandler>(5, 20, true);
+    auto third = std::make_shared<RecordingHandler>(0, 30, false);
+    first->set_successor(second);
+    second->set_successor(third);
+
+    CHECK(first->handle_request(7));
+    CHECK_FALSE(first->handle_request(25));
+    CHECK_FALSE(first->handle_request(42));
+
+    CHECK(first->requests == std::vector<int>{7});
+    CHECK(second->requests == std::vector<int>{7});
+    CHECK(third->requests == std::vector<int>{25});
+}
+
+TEST_CASE("Long handler chain does not recurse", "[chain]")
+{
+    auto head = std::make_shared<RecordingHandler>(0, 1, false);
+    auto last = head;
+    for (int i = 1; i < 100'000; ++i)
+    {
+        auto next = std::make_shared<RecordingHandler>(i, i + 1, true);
+        last->set_successor(next);
+        last = next;
+    }
+
+    CHECK(head->handle_request(99'999));
+    CHECK(last->requests == std::vector<int>{99'999});
+}
+
+TEST_CASE("RequestRouter routes requests by declared ranges", "[router]")
+{
+    std::vector<std::string> log;
+    RequestRouter router;
+    router.add_handler(0, 10, logging(log, "low"));
+    router.add_handler(10, 20, logging(log, "mid"));
+    router.add_handler(20, 30, logging(log, "high"));
+
+    CHECK(router.handler_count() == 3);
+
+    SECTION("range is half open")
+    {
+        CHECK(router.handle_request(0));
+        CHECK(router.handle_request(9));
+        CHECK(router.handle_request(10));
+        CHECK(router.handle_request(29));
+        CHECK(log == std::vector<std::string>{"low", "low", "mid", "high"});
+    }
+
+    SECTION("request outside of all ranges is not handled")
+    {
+        CHECK_FALSE(router.handle_request(-1));
+        CHECK_FALSE(router.handle_request(30));
+        CHECK_FALSE(router.handle_request(INT_MIN));
+        CHECK_FALSE(router.handle_request(INT_MAX));
+        CHECK(log.empty());
+    }
+}
+
+TEST_CASE("RequestRouter keeps priority and short-circuit of a chain", "[router]")
+{
+    std::vector<std::string> log;
+    RequestRouter router;
+    router.add_handler(0, 100, logging(log, "passing", false));
+    router.add_handler(50, 60, logging(log, "accepting"));
+    router.add_handler(0, 100, logging(log, "never reached from 50 - 60"));
+    router.add_dynamic_handler([](int request) { return request % 2 == 0; }, logging(log, "even"));
+    router.add_dynamic_handler([](int) { return true; }, logging(log, "rest"));
+
+    SECTION("ranged handlers in the order they were added")
+    {
+        CHECK(router.handle_request(55));
+        CHECK(log == std::vector<std::string>{"passing", "accepting"});
+    }
+
+    SECTION("dynamic handlers after the ranged ones")
+    {
+        CHECK(router.handle_request(70));
+        CHECK(log == std::vector<std::string>{"passing", "never reached from 50 - 60"});
+    }
+
+    SECTION("dynamic handlers as a fallback chain")
+    {
+        CHECK(router.handle_request(200));
+        CHECK(router.handle_request(201));
+        CHECK(log == std::vector<std::string>{"even", "rest"});
+    }
+}
+
+TEST_CASE("RequestRouter rebuilds routes when a handler is added", "[router]")
+{
+    std::vector<std::string> log;
+    RequestRouter router;
+    router.add_handler(0, 10, logging(log, "first"));
+
+    CHECK_FALSE(router.handle_request(15));
+
+    router.add_handler(5, 20, logging(log, "second"));
+    CHECK(router.handle_request(15));
+    CHECK(router.handle_request(7));
+    CHECK(log == std::vector<std::string>{"second", "first"});
+}
+
+TEST_CASE("RequestRouter rejects a reversed range and ignores an empty one", "[router]")
+{
+    std::vector<std::string> log;
+    RequestRouter router;
+
+    CHECK_THROWS_AS(router.add_handler(10, 0, logging(log, "reversed")), std::invalid_argument);
+
+    router.add_handler(10, 10, logging(log, "empty"));
+    CHECK_FALSE(router.handle_request(10));
+    CHECK(log.empty());
+}
+
+TEST_CASE("RequestRouter routes the same with a table and with a search", "[router]")
+{
+    std::mt19937 generator{42};
+
+    for (const int span : {1'000, INT_MAX})
+    {
+        std::uniform_int_distribution<int> bound{-span, span};
+
+        std::vector<std::pair<int, int>> ranges;
+        for (int i = 0; i < 50; ++i)
+        {
+            auto low = bound(generator), high = bound(generator);
+            ranges.emplace_back(std::min(low, high), std::max(low, high));
+        }
+
+        std::vector<std::size_t> routed, expected;
+        RequestRouter router;
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+            router.add_handler(ranges[i].first, ranges[i].second, [&routed, i](int) { routed.push_back(i); return i % 3 == 0; });
+
+        for (int n = 0; n < 2'000; ++n)
+        {
+            const int request = n < 20 ? ranges[n].first + n % 2 : bound(generator);
+
+            for (std::size_t i = 0; i < ranges.size(); ++i)
+            {
+                if (request >= ranges[i].first && request < ranges[i].second)
+                {
+                    expected.push_back(i);
+                    if (i % 3 == 0)
+                        break;
+                }
+            }
+
+            router.handle_request(request);
+        }
+
+        CHECK(routed == expected);
+    }
+}
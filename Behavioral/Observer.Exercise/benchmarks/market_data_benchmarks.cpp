@@ -0,0 +1,159 @@
+#include "market_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int symbol_count = 5'000;
+    constexpr int investor_count = 20'000;
+    constexpr int subscriptions_per_investor = 10;
+    constexpr int tick_count = 2'000'000;
+
+    class CountingInvestor : public Observer
+    {
+    public:
+        std::size_t updates = 0;
+        double last_price = 0.0;
+
+        void update(const Stock& stock) override
+        {
+            ++updates;
+            last_price = stock.get_price();
+        }
+
+        void update(const std::vector<const Stock*>& stocks) override
+        {
+            updates += stocks.size();
+            last_price = stocks.back()->get_price();
+        }
+    };
+
+    std::string symbol_name(int index)
+    {
+        return "SYM" + std::to_string(index);
+    }
+
+    // Synthetic tick file - random walk of prices, symbol popularity skewed like in real feeds
+    const std::filesystem::path& tick_file()
+    {
+        static const std::filesystem::path path = [] {
+            auto path = std::filesystem::temp_directory_path() / "observer_exercise_ticks.txt";
+
+            std::ofstream out{path};
+            std::mt19937 gen{42};
+            std::geometric_distribution<int> symbol{0.001};
+            std::normal_distribution<double> change{0.0, 0.5};
+            std::vector<double> prices(symbol_count, 100.0);
+
+            char buffer[32];
+            for (int i = 0; i < tick_count; ++i)
+            {
+                const int s = symbol(gen) % symbol_count;
+                prices[s] = std::max(0.01, prices[s] + change(gen));
+                std::snprintf(buffer, sizeof(buffer), "%.2f", prices[s]);
+                out << symbol_name(s) << ' ' << buffer << '\n';
+            }
+
+            return path;
+        }();
+
+        return path;
+    }
+
+    struct Market
+    {
+        MarketDataFeed feed;
+        std::vector<CountingInvestor> investors{investor_count};
+
+        Market()
+        {
+            for (int s = 0; s < symbol_count; ++s)
+                feed.add_stock(symbol_name(s), 100.0);
+
+            std::mt19937 gen{7};
+            std::uniform_int_distribution<SymbolId> symbol{0, symbol_count - 1};
+            for (auto& investor : investors)
+                for (int i = 0; i < subscriptions_per_investor; ++i)
+                    feed.subscribe(symbol(gen), &investor);
+        }
+    };
+}
+
+static void BM_MarketData_LoadTickFile(benchmark::State& state)
+{
+    const auto& path = tick_file();
+
+    for (auto _ : state)
+    {
+        MarketDataFeed feed;
+        std::ifstream in{path, std::ios::binary};
+        auto ticks = read_ticks(in, feed);
+        benchmark::DoNotOptimize(ticks.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(std::filesystem::file_size(path)));
+    state.SetItemsProcessed(state.iterations() * tick_count);
+}
+BENCHMARK(BM_MarketData_LoadTickFile)->Unit(benchmark::kMillisecond);
+
+static void BM_MarketData_Replay(benchmark::State& state)
+{
+    const std::size_t batch_size = state.range(0);
+
+    Market market;
+    std::ifstream in{tick_file(), std::ios::binary};
+    const auto ticks = read_ticks(in, market.feed);
+
+    for (auto _ : state)
+    {
+        for (std::size_t first = 0; first < ticks.size(); first += batch_size)
+        {
+            const std::size_t last = std::min(ticks.size(), first + batch_size);
+            market.feed.apply(ticks.begin() + first, ticks.begin() + last);
+        }
+    }
+
+    std::size_t updates = 0;
+    for (const auto& investor : market.investors)
+        updates += investor.updates;
+
+    state.SetItemsProcessed(state.iterations() * ticks.size());
+    state.counters["investor_updates/tick"] = static_cast<double>(updates) / (state.iterations() * ticks.size());
+}
+BENCHMARK(BM_MarketData_Replay)->Arg(1)->Arg(100)->Arg(10'000)->Unit(benchmark::kMillisecond);
+
+// Baseline - every investor subscribed directly to Stock and notified on every tick
+static void BM_MarketData_ReplayPerTick(benchmark::State& state)
+{
+    Market market;
+    std::ifstream in{tick_file(), std::ios::binary};
+    const auto ticks = read_ticks(in, market.feed);
+
+    std::vector<Stock> stocks;
+    stocks.reserve(symbol_count);
+    for (int s = 0; s < symbol_count; ++s)
+        stocks.emplace_back(symbol_name(s), 100.0);
+
+    std::mt19937 gen{7};
+    std::uniform_int_distribution<SymbolId> symbol{0, symbol_count - 1};
+    for (auto& investor : market.investors)
+        for (int i = 0; i < subscriptions_per_investor; ++i)
+            stocks[symbol(gen)].subscribe(&investor);
+
+    for (auto _ : state)
+    {
+        for (const Tick& tick : ticks)
+            stocks[tick.symbol].set_price(tick.price);
+    }
+
+    state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_MarketData_ReplayPerTick)->Unit(benchmark::kMillisecond);
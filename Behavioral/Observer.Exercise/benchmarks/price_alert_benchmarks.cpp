@@ -0,0 +1,112 @@
+#include "stock.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int tick_count = 10'000;
+
+    class AlertCounter : public Observer
+    {
+    public:
+        std::size_t alerts = 0;
+
+        void update(const Stock&) override
+        {
+        }
+
+        void update(const Stock&, const PriceAlert&) override
+        {
+            ++alerts;
+        }
+    };
+
+    // Baseline - notified on every change, checks its threshold itself
+    class FilteringInvestor : public Observer
+    {
+        double threshold_;
+        double last_price_;
+
+    public:
+        std::size_t alerts = 0;
+
+        FilteringInvestor(double threshold, double price) : threshold_{threshold}, last_price_{price}
+        {
+        }
+
+        void update(const Stock& stock) override
+        {
+            const double price = stock.get_price();
+            if ((last_price_ <= threshold_) != (price <= threshold_))
+                ++alerts;
+            last_price_ = price;
+        }
+    };
+
+    std::vector<double> random_walk(double start)
+    {
+        std::mt19937 gen{42};
+        std::normal_distribution<double> change{0.0, 0.1};
+
+        std::vector<double> prices(tick_count);
+        double price = start;
+        for (double& p : prices)
+            p = price = std::max(1.0, price + change(gen));
+        return prices;
+    }
+
+    std::vector<double> thresholds(std::size_t count)
+    {
+        std::mt19937 gen{7};
+        std::uniform_real_distribution<double> threshold{50.0, 150.0};
+
+        std::vector<double> result(count);
+        for (double& t : result)
+            t = threshold(gen);
+        return result;
+    }
+}
+
+static void BM_PriceAlerts_Indexed(benchmark::State& state)
+{
+    const auto prices = random_walk(100.0);
+    Stock stock("IBM", 100.0);
+    std::vector<AlertCounter> investors(state.range(0));
+    const auto levels = thresholds(investors.size());
+    for (std::size_t i = 0; i < investors.size(); ++i)
+        stock.add_alert(&investors[i], AlertCondition::crossing, levels[i]);
+
+    for (auto _ : state)
+    {
+        for (double price : prices)
+            stock.set_price(price);
+        stock.set_price(100.0);
+    }
+
+    state.SetItemsProcessed(state.iterations() * (tick_count + 1));
+}
+BENCHMARK(BM_PriceAlerts_Indexed)->RangeMultiplier(10)->Range(100, 100'000);
+
+static void BM_PriceAlerts_FilterInUpdate(benchmark::State& state)
+{
+    const auto prices = random_walk(100.0);
+    Stock stock("IBM", 100.0);
+    std::vector<FilteringInvestor> investors;
+    investors.reserve(state.range(0));
+    for (double level : thresholds(state.range(0)))
+        stock.subscribe(&investors.emplace_back(level, 100.0));
+
+    for (auto _ : state)
+    {
+        for (double price : prices)
+            stock.set_price(price);
+        stock.set_price(100.0);
+    }
+
+    state.SetItemsProcessed(state.iterations() * (tick_count + 1));
+}
+BENCHMARK(BM_PriceAlerts_FilterInUpdate)->RangeMultiplier(10)->Range(100, 100'000);
@@ -9,13 +9,21 @@ int main()
     Stock tpsa("TPSA", 95.0);
 
     // rejestracja inwestorow zainteresowanych powiadomieniami o zmianach kursu spolek
-    // TODO:
+    Investor kulczyk_holding("Kulczyk Holding");
+    Investor solorz_inc("Solorz Inc.");
+
+    misys.subscribe(&kulczyk_holding);
+    ibm.subscribe(&kulczyk_holding);
+    ibm.subscribe(&solorz_inc);
+    tpsa.subscribe(&solorz_inc);
 
     // zmian kursow
     misys.set_price(360.0);
     ibm.set_price(210.0);
     tpsa.set_price(45.0);
 
+    ibm.unsubscribe(&kulczyk_holding);
+
     misys.set_price(380.0);
     ibm.set_price(230.0);
     tpsa.set_price(15.0);
@@ -0,0 +1,345 @@
+#ifndef MARKET_DATA_HPP_
+#define MARKET_DATA_HPP_
+
+#include "stock.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using SymbolId = std::uint32_t;
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Interns symbol names - every name gets a dense id, so the rest of the engine works on indices
+class SymbolTable
+{
+    std::deque<std::string> names_; // deque keeps the strings (and views of them) in place
+    std::unordered_map<std::string_view, SymbolId> ids_;
+
+public:
+    SymbolId intern(std::string_view name)
+    {
+        if (auto it = ids_.find(name); it != ids_.end())
+            return it->second;
+
+        const auto id = static_cast<SymbolId>(names_.size());
+        names_.emplace_back(name);
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+
+    std::optional<SymbolId> find(std::string_view name) const
+    {
+        if (auto it = ids_.find(name); it != ids_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    const std::string& name(SymbolId id) const
+    {
+        return names_[id];
+    }
+
+    std::size_t size() const
+    {
+        return names_.size();
+    }
+};
+
+struct Tick
+{
+    SymbolId symbol;
+    double price;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Fans price updates of many stocks out to many investors.
+//
+// Subscribers of every symbol are kept in an array of dense investor indices. apply() updates
+// the prices of a whole batch of ticks first and then notifies every affected investor once,
+// with the list of its stocks that changed (in order of their first tick in the batch).
+// A stock ticking several times in one batch is reported once, with its last price.
+//
+// Observers subscribed directly to a Stock are still notified on every price change.
+// Subscribing and unsubscribing from inside update() is not supported.
+class MarketDataFeed
+{
+    using InvestorId = std::uint32_t;
+
+    SymbolTable symbols_;
+    std::deque<Stock> stocks_; // indexed by SymbolId
+    std::vector<std::vector<InvestorId>> subscribers_;
+
+    std::vector<Observer*> investors_;
+    std::unordered_map<Observer*, InvestorId> investor_ids_;
+    std::unordered_set<std::uint64_t> subscriptions_; // (symbol, investor) pairs - duplicates are found in O(1)
+
+    // State of the batch being applied - stamps avoid clearing per-symbol/per-investor flags.
+    // Changes are grouped per investor in flat arrays (counting sort), not in a vector per investor,
+    // so a batch touches a few contiguous buffers regardless of the number of investors.
+    struct InvestorState
+    {
+        std::uint32_t batch;
+        std::uint32_t slot; // position in notified_investors_
+    };
+
+    std::uint32_t batch_ = 0;
+    std::vector<std::uint32_t> symbol_batch_;
+    std::vector<InvestorState> investor_state_;
+    std::vector<SymbolId> changed_symbols_;
+    std::vector<InvestorId> notified_investors_;
+    std::vector<std::size_t> offsets_; // changes of notified investor k end at grouped_[offsets_[k]]
+    std::vector<const Stock*> grouped_;
+    std::vector<const Stock*> changes_;
+
+public:
+    SymbolId add_stock(std::string_view symbol, double price)
+    {
+        const SymbolId id = symbols_.intern(symbol);
+        if (id == stocks_.size())
+        {
+            stocks_.emplace_back(symbols_.name(id), price);
+            subscribers_.emplace_back();
+            symbol_batch_.push_back(0);
+        }
+        return id;
+    }
+
+    std::optional<SymbolId> find(std::string_view symbol) const
+    {
+        return symbols_.find(symbol);
+    }
+
+    const SymbolTable& symbols() const
+    {
+        return symbols_;
+    }
+
+    Stock& stock(SymbolId id)
+    {
+        return stocks_.at(id);
+    }
+
+    const Stock& stock(SymbolId id) const
+    {
+        return stocks_.at(id);
+    }
+
+    std::size_t stock_count() const
+    {
+        return stocks_.size();
+    }
+
+    void subscribe(SymbolId symbol, Observer* investor)
+    {
+        auto& subscribers = subscribers_.at(symbol);
+        const InvestorId id = investor_id(investor);
+        if (subscriptions_.insert(subscription(symbol, id)).second)
+            subscribers.push_back(id);
+    }
+
+    void subscribe(std::string_view symbol, Observer* investor)
+    {
+        subscribe(existing_symbol(symbol), investor);
+    }
+
+    void unsubscribe(SymbolId symbol, Observer* investor)
+    {
+        auto& subscribers = subscribers_.at(symbol);
+        auto it = investor_ids_.find(investor);
+        if (it == investor_ids_.end() || subscriptions_.erase(subscription(symbol, it->second)) == 0)
+            return;
+
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), it->second), subscribers.end());
+    }
+
+    void unsubscribe(std::string_view symbol, Observer* investor)
+    {
+        unsubscribe(existing_symbol(symbol), investor);
+    }
+
+    template <typename TIterator>
+    void apply(TIterator first, TIterator last)
+    {
+        begin_batch();
+
+        for (; first != last; ++first)
+        {
+            const Tick& tick = *first;
+            Stock& stock = stocks_.at(tick.symbol);
+            if (stock.get_price() == tick.price)
+                continue;
+
+            stock.set_price(tick.price);
+            if (symbol_batch_[tick.symbol] != batch_)
+            {
+                symbol_batch_[tick.symbol] = batch_;
+                changed_symbols_.push_back(tick.symbol);
+            }
+        }
+
+        notify_investors();
+    }
+
+    void apply(const std::vector<Tick>& ticks)
+    {
+        apply(ticks.begin(), ticks.end());
+    }
+
+private:
+    SymbolId existing_symbol(std::string_view symbol) const
+    {
+        if (auto id = symbols_.find(symbol))
+            return *id;
+        throw std::invalid_argument("Unknown symbol: " + std::string(symbol));
+    }
+
+    static std::uint64_t subscription(SymbolId symbol, InvestorId investor)
+    {
+        return static_cast<std::uint64_t>(symbol) << 32 | investor;
+    }
+
+    InvestorId investor_id(Observer* investor)
+    {
+        auto [it, inserted] = investor_ids_.emplace(investor, static_cast<InvestorId>(investors_.size()));
+        if (inserted)
+        {
+            investors_.push_back(investor);
+            investor_state_.push_back(InvestorState{0, 0});
+        }
+        return it->second;
+    }
+
+    void begin_batch()
+    {
+        if (++batch_ == 0) // stamps wrapped around - reset them
+        {
+            std::fill(symbol_batch_.begin(), symbol_batch_.end(), 0);
+            std::fill(investor_state_.begin(), investor_state_.end(), InvestorState{0, 0});
+            batch_ = 1;
+        }
+
+        changed_symbols_.clear();
+        notified_investors_.clear();
+        offsets_.clear();
+    }
+
+    void notify_investors()
+    {
+        if (changed_symbols_.size() == 1) // every investor gets one stock - no grouping needed
+        {
+            changes_.assign(1, &stocks_[changed_symbols_.front()]);
+            for (InvestorId investor : subscribers_[changed_symbols_.front()])
+                investors_[investor]->update(changes_);
+            return;
+        }
+
+        // counting sort of (investor, stock) pairs - first count the changes of every investor...
+        for (SymbolId symbol : changed_symbols_)
+        {
+            for (InvestorId investor : subscribers_[symbol])
+            {
+                InvestorState& state = investor_state_[investor];
+                if (state.batch != batch_)
+                {
+                    state = InvestorState{batch_, static_cast<std::uint32_t>(notified_investors_.size())};
+                    notified_investors_.push_back(investor);
+                    offsets_.push_back(0);
+                }
+                ++offsets_[state.slot];
+            }
+        }
+
+        std::size_t start = 0;
+        for (std::size_t& offset : offsets_)
+            start += std::exchange(offset, start);
+
+        // ...then scatter the stocks into per-investor groups, keeping the order of ticks
+        grouped_.resize(start);
+        for (SymbolId symbol : changed_symbols_)
+        {
+            const Stock* stock = &stocks_[symbol];
+            for (InvestorId investor : subscribers_[symbol])
+                grouped_[offsets_[investor_state_[investor].slot]++] = stock;
+        }
+
+        // scattering moved every offset to the end of its group
+        std::size_t first = 0;
+        for (std::size_t k = 0; k < notified_investors_.size(); ++k)
+        {
+            changes_.assign(grouped_.begin() + first, grouped_.begin() + offsets_[k]);
+            investors_[notified_investors_[k]]->update(changes_);
+            first = offsets_[k];
+        }
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Reads ticks in text format - one "SYMBOL PRICE" pair per line, e.g. "IBM 245.5".
+// Unknown symbols are added to the feed with the price of their first tick.
+inline std::vector<Tick> read_ticks(std::istream& in, MarketDataFeed& feed)
+{
+    const std::string text{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+    std::vector<Tick> ticks;
+    const char* pos = text.data();
+    const char* const end = pos + text.size();
+    std::size_t line = 1;
+
+    auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+
+    while (pos != end)
+    {
+        while (pos != end && is_space(*pos))
+            ++pos;
+
+        if (pos != end && *pos == '\n')
+        {
+            ++pos;
+            ++line;
+            continue;
+        }
+
+        if (pos == end)
+            break;
+
+        const char* symbol_end = pos;
+        while (symbol_end != end && !is_space(*symbol_end) && *symbol_end != '\n')
+            ++symbol_end;
+        const std::string_view symbol(pos, symbol_end - pos);
+
+        pos = symbol_end;
+        while (pos != end && is_space(*pos))
+            ++pos;
+
+        double price;
+        auto [price_end, error] = std::from_chars(pos, end, price);
+        if (error != std::errc{} || !std::isfinite(price))
+            throw std::runtime_error("Invalid tick in line " + std::to_string(line));
+        pos = price_end;
+
+        while (pos != end && is_space(*pos))
+            ++pos;
+        if (pos != end && *pos != '\n')
+            throw std::runtime_error("Invalid tick in line " + std::to_string(line));
+
+        const auto id = feed.find(symbol);
+        ticks.push_back(Tick{id ? *id : feed.add_stock(symbol, price), price});
+    }
+
+    return ticks;
+}
+
+#endif /*MARKET_DATA_HPP_*/
@@ -1,31 +1,105 @@
 #ifndef STOCK_HPP_
 #define STOCK_HPP_
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+class Stock;
+
+enum class AlertCondition
+{
+    above,   // price rises above the threshold (old <= threshold < new)
+    below,   // price falls to or under the threshold (new <= threshold < old)
+    crossing // either of the above
+};
+
+struct PriceAlert
+{
+    double threshold;
+    AlertCondition condition;
+};
+
+using AlertId = std::uint64_t;
 
 class Observer
 {
 public:
-    virtual void update(/*...*/) = 0;
+    virtual void update(const Stock& stock) = 0;
+
+    // Batch of price changes - every stock appears once. By default forwarded to update(const Stock&).
+    virtual void update(const std::vector<const Stock*>& stocks)
+    {
+        for (const Stock* stock : stocks)
+            update(*stock);
+    }
+
+    // Price alert registered with Stock::add_alert has fired. By default forwarded to update(const Stock&).
+    virtual void update(const Stock& stock, const PriceAlert& /*alert*/)
+    {
+        update(stock);
+    }
+
     virtual ~Observer()
     {
     }
 };
 
 // Subject
+//
+// Besides plain observers (notified on every change) a stock keeps price alerts. Alerts are indexed
+// by threshold in sorted maps - one for rising and one for falling prices - so a price change
+// visits only the alerts whose thresholds it crossed: O(log n + k).
 class Stock
 {
 private:
+    struct Alert
+    {
+        Observer* observer;
+        PriceAlert alert;
+        AlertId id;
+    };
+
+    using AlertIndex = std::multimap<double, Alert>;
+
+    // end() iterators do not survive moving a map (e.g. when a vector of stocks grows), so
+    // missing entries are marked with flags
+    struct AlertEntry
+    {
+        AlertIndex::iterator rising;
+        AlertIndex::iterator falling;
+        bool is_rising;
+        bool is_falling;
+    };
+
     std::string symbol_;
     double price_;
-    // TODO - kontener przechowywujacy obserwatorow
+    std::vector<Observer*> observers_;
+
+    AlertIndex rising_alerts_;  // above & crossing
+    AlertIndex falling_alerts_; // below & crossing
+    std::unordered_map<AlertId, AlertEntry> alerts_;
+    AlertId next_alert_id_ = 0;
+    std::vector<Alert> fired_alerts_;
+
 public:
-    Stock(const std::string& symbol, double price) : symbol_(symbol), price_(price)
+    Stock(const std::string& symbol, double price) : symbol_(symbol), price_(check_finite(price))
     {
     }
 
-    std::string get_symbol() const
+    // alerts_ holds iterators into the alert maps of this stock - a copy would share them
+    Stock(const Stock&) = delete;
+    Stock& operator=(const Stock&) = delete;
+    Stock(Stock&&) = default;
+    Stock& operator=(Stock&&) = default;
+
+    const std::string& get_symbol() const
     {
         return symbol_;
     }
@@ -35,30 +109,136 @@ public:
         return price_;
     }
 
-    // TODO: rejestracja obserwatora
+    void subscribe(Observer* observer)
+    {
+        observers_.push_back(observer);
+    }
+
+    void unsubscribe(Observer* observer)
+    {
+        observers_.erase(std::remove(observers_.begin(), observers_.end(), observer), observers_.end());
+    }
+
+    AlertId add_alert(Observer* observer, AlertCondition condition, double threshold)
+    {
+        check_finite(threshold); // NaN would break the order of the alert index
+        const AlertId id = next_alert_id_++;
+        const Alert alert{observer, PriceAlert{threshold, condition}, id};
+        AlertEntry entry{{}, {}, condition != AlertCondition::below, condition != AlertCondition::above};
+
+        if (entry.is_rising)
+            entry.rising = rising_alerts_.emplace(threshold, alert);
+        if (entry.is_falling)
+            entry.falling = falling_alerts_.emplace(threshold, alert);
+
+        alerts_.emplace(id, entry);
+        return id;
+    }
+
+    void remove_alert(AlertId id)
+    {
+        auto it = alerts_.find(id);
+        if (it == alerts_.end())
+            return;
+
+        if (it->second.is_rising)
+            rising_alerts_.erase(it->second.rising);
+        if (it->second.is_falling)
+            falling_alerts_.erase(it->second.falling);
+
+        alerts_.erase(it);
+    }
 
-    // TODO: wyrejestrowanie obserwatora
+    std::size_t alert_count() const
+    {
+        return alerts_.size();
+    }
 
     void set_price(double price)
     {
+        check_finite(price);
+
+        if (price_ == price)
+            return;
+
+        const double old_price = price_;
         price_ = price;
 
-        // TODO: powiadomienie inwestorow o zmianie kursu...
+        for (Observer* observer : observers_)
+            observer->update(*this);
+
+        fire_alerts(old_price, price);
+    }
+
+private:
+    static double check_finite(double value)
+    {
+        if (!std::isfinite(value))
+            throw std::invalid_argument("Price must be finite");
+        return value;
+    }
+
+    // Alerts are collected before any is fired, so observers may add and remove alerts in update().
+    // An alert removed in update() does not fire any more, one added does not fire for this change.
+    void fire_alerts(double old_price, double new_price)
+    {
+        fired_alerts_.clear();
+
+        if (new_price > old_price) // thresholds in [old, new) - in the order the price passed them
+        {
+            const auto last = rising_alerts_.lower_bound(new_price);
+            for (auto it = rising_alerts_.lower_bound(old_price); it != last; ++it)
+                fired_alerts_.push_back(it->second);
+        }
+        else // thresholds in [new, old)
+        {
+            const auto first = falling_alerts_.lower_bound(new_price);
+            for (auto it = falling_alerts_.lower_bound(old_price); it != first;)
+                fired_alerts_.push_back((--it)->second);
+        }
+
+        if (fired_alerts_.empty())
+            return;
+
+        std::vector<Alert> fired;
+        fired.swap(fired_alerts_); // the buffer is reused, but a nested set_price() gets its own
+
+        for (const Alert& alert : fired)
+        {
+            if (alerts_.count(alert.id) != 0)
+                alert.observer->update(*this, alert.alert);
+        }
+
+        fired.clear();
+        fired_alerts_.swap(fired);
     }
 };
 
 class Investor : public Observer
 {
     std::string name_;
+    std::ostream& out_;
 
 public:
-    Investor(const std::string& name) : name_(name)
+    Investor(const std::string& name, std::ostream& out = std::cout) : name_(name), out_(out)
+    {
+    }
+
+    const std::string& name() const
+    {
+        return name_;
+    }
+
+    using Observer::update;
+
+    void update(const Stock& stock) override
     {
+        out_ << name_ << " notified: " << stock.get_symbol() << " - " << stock.get_price() << "\n";
     }
 
-    void update(/*...*/)
+    void update(const Stock& stock, const PriceAlert& alert) override
     {
-        // TODO: implementacja
+        out_ << name_ << " alerted: " << stock.get_symbol() << " crossed " << alert.threshold << " - " << stock.get_price() << "\n";
     }
 };
 
@@ -0,0 +1,169 @@
+#include "market_data.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    class RecordingInvestor : public Observer
+    {
+    public:
+        std::vector<std::string> updates;
+        std::vector<std::vector<std::string>> batches;
+
+        void update(const Stock& stock) override
+        {
+            updates.push_back(stock.get_symbol() + " " + std::to_string(static_cast<int>(stock.get_price())));
+        }
+
+        void update(const std::vector<const Stock*>& stocks) override
+        {
+            std::vector<std::string> batch;
+            for (const Stock* stock : stocks)
+                batch.push_back(stock->get_symbol() + " " + std::to_string(static_cast<int>(stock->get_price())));
+            batches.push_back(batch);
+        }
+    };
+}
+
+TEST_CASE("Stock notifies subscribed investors", "[stock]")
+{
+    Stock ibm("IBM", 245.0);
+    RecordingInvestor first, second;
+
+    ibm.subscribe(&first);
+    ibm.subscribe(&second);
+    ibm.set_price(210.0);
+    ibm.set_price(210.0); // no change - no notification
+
+    ibm.unsubscribe(&second);
+    ibm.set_price(230.0);
+
+    REQUIRE(first.updates == std::vector<std::string>{"IBM 210", "IBM 230"});
+    REQUIRE(second.updates == std::vector<std::string>{"IBM 210"});
+}
+
+TEST_CASE("Investor prints price changes", "[stock]")
+{
+    std::ostringstream out;
+    Investor investor("Kulczyk Holding", out);
+    Stock misys("Misys", 340.0);
+
+    misys.subscribe(&investor);
+    misys.set_price(360.0);
+
+    REQUIRE(out.str() == "Kulczyk Holding notified: Misys - 360\n");
+}
+
+TEST_CASE("SymbolTable interns names", "[market_data]")
+{
+    SymbolTable symbols;
+
+    const SymbolId ibm = symbols.intern("IBM");
+    const SymbolId tpsa = symbols.intern("TPSA");
+
+    REQUIRE(ibm != tpsa);
+    REQUIRE(symbols.intern(std::string("IBM")) == ibm);
+    REQUIRE(symbols.name(tpsa) == "TPSA");
+    REQUIRE(symbols.find("TPSA") == tpsa);
+    REQUIRE_FALSE(symbols.find("MSFT").has_value());
+    REQUIRE(symbols.size() == 2);
+}
+
+TEST_CASE("MarketDataFeed notifies every investor once per batch", "[market_data]")
+{
+    MarketDataFeed feed;
+    const SymbolId ibm = feed.add_stock("IBM", 245.0);
+    const SymbolId misys = feed.add_stock("Misys", 340.0);
+    const SymbolId tpsa = feed.add_stock("TPSA", 95.0);
+
+    RecordingInvestor both, only_tpsa, none;
+    feed.subscribe(ibm, &both);
+    feed.subscribe("Misys", &both);
+    feed.subscribe(tpsa, &only_tpsa);
+    feed.subscribe(tpsa, &only_tpsa); // subscribing twice is harmless
+
+    feed.apply({{misys, 350.0}, {ibm, 250.0}, {misys, 360.0}, {ibm, 250.0}});
+
+    REQUIRE(both.batches == std::vector<std::vector<std::string>>{{"Misys 360", "IBM 250"}});
+    REQUIRE(only_tpsa.batches.empty());
+    REQUIRE(feed.stock(misys).get_price() == 360.0);
+
+    SECTION("unchanged prices are not reported")
+    {
+        feed.apply({{ibm, 250.0}, {tpsa, 90.0}});
+
+        REQUIRE(both.batches.size() == 1);
+        REQUIRE(only_tpsa.batches == std::vector<std::vector<std::string>>{{"TPSA 90"}});
+    }
+
+    SECTION("unsubscribed investors are not notified")
+    {
+        feed.unsubscribe(ibm, &both);
+        feed.apply({{ibm, 260.0}, {misys, 370.0}});
+
+        REQUIRE(both.batches.back() == std::vector<std::string>{"Misys 370"});
+    }
+
+    SECTION("resubscribing after unsubscribe")
+    {
+        feed.unsubscribe(tpsa, &only_tpsa);
+        feed.unsubscribe(tpsa, &only_tpsa);
+        feed.subscribe(tpsa, &only_tpsa);
+        feed.subscribe(tpsa, &only_tpsa);
+        feed.apply({{tpsa, 90.0}});
+
+        REQUIRE(only_tpsa.batches == std::vector<std::vector<std::string>>{{"TPSA 90"}});
+    }
+
+    SECTION("unknown symbols are rejected")
+    {
+        REQUIRE_THROWS_AS(feed.subscribe("MSFT", &none), std::invalid_argument);
+    }
+}
+
+TEST_CASE("MarketDataFeed forwards batches to update(const Stock&) by default", "[market_data]")
+{
+    MarketDataFeed feed;
+    const SymbolId ibm = feed.add_stock("IBM", 245.0);
+    const SymbolId tpsa = feed.add_stock("TPSA", 95.0);
+
+    std::ostringstream out;
+    Investor investor("Solorz Inc.", out);
+    feed.subscribe(ibm, &investor);
+    feed.subscribe(tpsa, &investor);
+
+    feed.apply({{tpsa, 45.0}, {ibm, 210.0}});
+
+    REQUIRE(out.str() == "Solorz Inc. notified: TPSA - 45\nSolorz Inc. notified: IBM - 210\n");
+}
+
+TEST_CASE("read_ticks parses a tick file", "[market_data]")
+{
+    MarketDataFeed feed;
+    const SymbolId ibm = feed.add_stock("IBM", 245.0);
+
+    std::istringstream in{"IBM 250.5\n\n  TPSA\t95\r\nIBM 251"};
+    const auto ticks = read_ticks(in, feed);
+
+    REQUIRE(ticks.size() == 3);
+    REQUIRE(ticks[0].symbol == ibm);
+    REQUIRE(ticks[0].price == 250.5);
+    REQUIRE(ticks[1].symbol == *feed.find("TPSA"));
+    REQUIRE(feed.stock(ticks[1].symbol).get_price() == 95.0);
+    REQUIRE(ticks[2].price == 251.0);
+
+    SECTION("invalid lines are reported")
+    {
+        std::istringstream invalid{"IBM 250\nTPSA abc\n"};
+        REQUIRE_THROWS_WITH(read_ticks(invalid, feed), "Invalid tick in line 2");
+    }
+
+    SECTION("non-finite prices are reported")
+    {
+        std::istringstream invalid{"IBM nan\n"};
+        REQUIRE_THROWS_WITH(read_ticks(invalid, feed), "Invalid tick in line 1");
+    }
+}
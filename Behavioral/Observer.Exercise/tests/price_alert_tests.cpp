@@ -0,0 +1,198 @@
+#include "stock.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    class AlertRecorder : public Observer
+    {
+    public:
+        std::vector<double> thresholds;
+        std::size_t updates = 0;
+        std::function<void(const PriceAlert&)> on_alert;
+
+        void update(const Stock&) override
+        {
+            ++updates;
+        }
+
+        void update(const Stock&, const PriceAlert& alert) override
+        {
+            thresholds.push_back(alert.threshold);
+            if (on_alert)
+                on_alert(alert);
+        }
+    };
+}
+
+TEST_CASE("Price alerts fire only when the threshold is crossed", "[stock][alerts]")
+{
+    Stock ibm("IBM", 100.0);
+    AlertRecorder above, below, crossing;
+
+    ibm.add_alert(&above, AlertCondition::above, 110.0);
+    ibm.add_alert(&below, AlertCondition::below, 90.0);
+    ibm.add_alert(&crossing, AlertCondition::crossing, 105.0);
+
+    ibm.set_price(104.0);
+    REQUIRE(above.thresholds.empty());
+    REQUIRE(crossing.thresholds.empty());
+
+    ibm.set_price(111.0);
+    REQUIRE(above.thresholds == std::vector{110.0});
+    REQUIRE(crossing.thresholds == std::vector{105.0});
+
+    ibm.set_price(115.0); // still above - nothing crossed
+    REQUIRE(above.thresholds.size() == 1);
+
+    ibm.set_price(80.0);
+    REQUIRE(above.thresholds.size() == 1);
+    REQUIRE(below.thresholds == std::vector{90.0});
+    REQUIRE(crossing.thresholds == std::vector{105.0, 105.0});
+
+    REQUIRE(above.updates == 0); // not subscribed to every change
+}
+
+TEST_CASE("Price alerts fire at the threshold once per crossing", "[stock][alerts]")
+{
+    Stock ibm("IBM", 100.0);
+    AlertRecorder recorder;
+    ibm.add_alert(&recorder, AlertCondition::crossing, 100.0);
+
+    ibm.set_price(101.0); // 100 -> above
+    ibm.set_price(100.0); // back to the threshold
+    ibm.set_price(99.0);  // already at the threshold - no new crossing
+    ibm.set_price(100.0);
+    ibm.set_price(100.5);
+
+    REQUIRE(recorder.thresholds == std::vector{100.0, 100.0, 100.0});
+}
+
+TEST_CASE("Price alerts fire in the order the price passes them", "[stock][alerts]")
+{
+    Stock ibm("IBM", 100.0);
+    AlertRecorder recorder;
+    for (double threshold : {120.0, 80.0, 110.0, 90.0, 130.0})
+        ibm.add_alert(&recorder, AlertCondition::crossing, threshold);
+
+    ibm.set_price(125.0);
+    REQUIRE(recorder.thresholds == std::vector{110.0, 120.0});
+
+    recorder.thresholds.clear();
+    ibm.set_price(85.0);
+    REQUIRE(recorder.thresholds == std::vector{120.0, 110.0, 90.0});
+}
+
+TEST_CASE("Price alerts can be removed", "[stock][alerts]")
+{
+    Stock ibm("IBM", 100.0);
+    AlertRecorder first, second;
+
+    const AlertId first_alert = ibm.add_alert(&first, AlertCondition::crossing, 110.0);
+    ibm.add_alert(&second, AlertCondition::above, 110.0);
+    REQUIRE(ibm.alert_count() == 2);
+
+    ibm.remove_alert(first_alert);
+    ibm.remove_alert(first_alert); // removing twice is harmless
+    ibm.set_price(120.0);
+    ibm.set_price(100.0);
+
+    REQUIRE(first.thresholds.empty());
+    REQUIRE(second.thresholds == std::vector{110.0});
+    REQUIRE(ibm.alert_count() == 1);
+
+    SECTION("an alert removed by an earlier alert does not fire")
+    {
+        AlertId third_alert{};
+        second.on_alert = [&](const PriceAlert&) { ibm.remove_alert(third_alert); };
+        AlertRecorder third;
+        third_alert = ibm.add_alert(&third, AlertCondition::above, 115.0);
+
+        ibm.set_price(120.0);
+
+        REQUIRE(second.thresholds.size() == 2);
+        REQUIRE(third.thresholds.empty());
+    }
+}
+
+TEST_CASE("Price alerts survive moving the stock", "[stock][alerts]")
+{
+    std::vector<Stock> stocks;
+    stocks.emplace_back("IBM", 100.0);
+    AlertRecorder recorder;
+    const AlertId alert = stocks[0].add_alert(&recorder, AlertCondition::below, 90.0);
+
+    for (int i = 0; i < 100; ++i)
+        stocks.emplace_back("S" + std::to_string(i), 1.0);
+
+    stocks[0].set_price(50.0);
+    stocks[0].remove_alert(alert);
+
+    REQUIRE(recorder.thresholds == std::vector{90.0});
+    REQUIRE(stocks[0].alert_count() == 0);
+}
+
+TEST_CASE("Stock with price alerts can be moved but not copied", "[stock][alerts]")
+{
+    STATIC_REQUIRE_FALSE(std::is_copy_constructible_v<Stock>);
+    STATIC_REQUIRE_FALSE(std::is_copy_assignable_v<Stock>);
+
+    AlertRecorder recorder;
+    Stock ibm("IBM", 100.0);
+    const AlertId removed = ibm.add_alert(&recorder, AlertCondition::above, 110.0);
+    ibm.add_alert(&recorder, AlertCondition::crossing, 120.0);
+
+    Stock moved("MSFT", 1.0);
+    moved = std::move(ibm);
+    moved.remove_alert(removed);
+    moved.set_price(130.0);
+
+    REQUIRE(recorder.thresholds == std::vector{120.0});
+    REQUIRE(moved.alert_count() == 1);
+}
+
+TEST_CASE("Non-finite prices and thresholds are rejected", "[stock][alerts]")
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    AlertRecorder recorder;
+    Stock stock("X", 10.0);
+    stock.add_alert(&recorder, AlertCondition::below, 5.0);
+    stock.add_alert(&recorder, AlertCondition::below, 20.0);
+
+    REQUIRE_THROWS_AS(stock.set_price(nan), std::invalid_argument);
+    REQUIRE_THROWS_AS(stock.set_price(-infinity), std::invalid_argument);
+    REQUIRE(stock.get_price() == 10.0);
+    REQUIRE(recorder.thresholds.empty());
+
+    REQUIRE_THROWS_AS(stock.add_alert(&recorder, AlertCondition::above, nan), std::invalid_argument);
+    REQUIRE_THROWS_AS(stock.add_alert(&recorder, AlertCondition::crossing, infinity), std::invalid_argument);
+    REQUIRE(stock.alert_count() == 2);
+
+    REQUIRE_THROWS_AS(Stock("Y", nan), std::invalid_argument);
+
+    stock.set_price(30.0);
+    stock.set_price(1.0);
+    REQUIRE(recorder.thresholds == std::vector{20.0, 5.0});
+}
+
+TEST_CASE("Investor prints alerts", "[stock][alerts]")
+{
+    std::ostringstream out;
+    Investor investor("Kulczyk Holding", out);
+    Stock misys("Misys", 340.0);
+
+    misys.add_alert(&investor, AlertCondition::above, 350.0);
+    misys.set_price(360.0);
+
+    REQUIRE(out.str() == "Kulczyk Holding alerted: Misys crossed 350 - 360\n");
+}
@@ -0,0 +1,395 @@
+#ifndef ASYNC_OBSERVER_HPP_
+#define ASYNC_OBSERVER_HPP_
+
+#include "observer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Bounded lock-free queue (D. Vyukov's array queue). Every cell carries a sequence number,
+// so besides the consumer also the producer may pop - that is how an overflowing queue
+// evicts its oldest events without a lock.
+template <typename T>
+class BoundedQueue
+{
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> buffer_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos_{0};
+
+public:
+    // capacity is rounded up to a power of two
+    explicit BoundedQueue(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+
+        buffer_ = std::make_unique<Cell[]>(size);
+        mask_ = size - 1;
+        for (std::size_t i = 0; i < size; ++i)
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    bool try_push(T&& value)
+    {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &buffer_[pos & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value)
+    {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &buffer_[pos & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->data);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        const std::size_t dequeued = dequeue_pos_.load();
+        const std::size_t enqueued = enqueue_pos_.load();
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// What notify() does when an observer is behind
+enum class Backpressure
+{
+    block,       // queue full - wait until the observer makes room
+    drop_oldest, // queue full - evict the oldest pending event
+    coalesce     // on every notify() - evict all pending events, the observer gets only the newest one
+};
+
+struct AsyncOptions
+{
+    std::size_t capacity = 1024;
+    Backpressure backpressure = Backpressure::block;
+};
+
+struct DeliveryStats
+{
+    std::size_t delivered;
+    std::size_t dropped;
+    std::size_t queue_depth;
+    std::size_t max_queue_depth;
+    std::chrono::nanoseconds average_latency; // from notify() to the start of update()
+    std::chrono::nanoseconds max_latency;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Observable that delivers events asynchronously - every observer has a bounded queue drained
+// by its own worker thread, so a slow observer does not stall the publisher.
+// Event arguments are copied (decayed) into the queues; the source must outlive the deliveries -
+// a derived class (the source) calls stop() in its destructor, otherwise events still pending
+// when the base is destroyed are dropped.
+// subscribe(), unsubscribe() and notify() must be called from a single publisher thread.
+template <typename TSource, typename... TEventArgs>
+class AsyncObservable
+{
+public:
+    using ObserverType = Observer<TSource, TEventArgs...>;
+
+    AsyncObservable() = default;
+    AsyncObservable(const AsyncObservable&) = delete;
+    AsyncObservable& operator=(const AsyncObservable&) = delete;
+
+    // The derived part is already destroyed - pending events are dropped, not delivered
+    ~AsyncObservable()
+    {
+        for (auto& channel : channels_)
+            channel->discard_pending();
+    }
+
+    void subscribe(ObserverType* observer, AsyncOptions options = {})
+    {
+        channels_.push_back(std::make_unique<Channel>(observer, options));
+    }
+
+    // Delivers events already queued for the observer and stops its worker
+    void unsubscribe(ObserverType* observer)
+    {
+        auto it = std::find_if(channels_.begin(), channels_.end(), [observer](const auto& channel) { return channel->observer() == observer; });
+        if (it != channels_.end())
+            channels_.erase(it);
+    }
+
+    DeliveryStats stats(ObserverType* observer) const
+    {
+        for (const auto& channel : channels_)
+            if (channel->observer() == observer)
+                return channel->stats();
+        return DeliveryStats{};
+    }
+
+    // Blocks until all events notified so far are delivered or dropped
+    void flush()
+    {
+        for (auto& channel : channels_)
+            channel->flush();
+    }
+
+protected:
+    // Delivers pending events and stops the workers of all observers - called by the destructor
+    // of a derived class, while the source is still alive
+    void stop()
+    {
+        channels_.clear();
+    }
+
+    void notify(TSource& source, EventParam<TEventArgs>... args)
+    {
+        const auto now = Clock::now();
+        for (auto& channel : channels_)
+            channel->push(Event{&source, std::tuple<std::decay_t<TEventArgs>...>{args...}, now});
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Event
+    {
+        TSource* source;
+        std::tuple<std::decay_t<TEventArgs>...> args;
+        Clock::time_point notified_at;
+    };
+
+    class Channel
+    {
+        ObserverType* observer_;
+        Backpressure backpressure_;
+        BoundedQueue<Event> queue_;
+
+        std::atomic<bool> stopping_{false};
+        std::atomic<bool> discarding_{false};
+        std::atomic<bool> sleeping_{false};
+        std::mutex wake_mutex_;
+        std::condition_variable wake_;
+
+        std::size_t pushed_ = 0; // publisher only
+        std::atomic<std::size_t> delivered_{0};
+        std::atomic<std::size_t> dropped_{0};
+        std::atomic<std::size_t> max_queue_depth_{0};
+        std::atomic<std::int64_t> total_latency_ns_{0};
+        std::atomic<std::int64_t> max_latency_ns_{0};
+
+        std::thread worker_;
+
+    public:
+        Channel(ObserverType* observer, AsyncOptions options)
+            : observer_{observer}, backpressure_{options.backpressure}, queue_{options.capacity}, worker_{[this] { run(); }}
+        {
+        }
+
+        Channel(const Channel&) = delete;
+        Channel& operator=(const Channel&) = delete;
+
+        ~Channel()
+        {
+            stopping_ = true;
+            {
+                std::lock_guard lk{wake_mutex_};
+                wake_.notify_one();
+            }
+            worker_.join();
+        }
+
+        ObserverType* observer() const
+        {
+            return observer_;
+        }
+
+        void push(Event&& event)
+        {
+            ++pushed_;
+
+            Event evicted;
+            if (backpressure_ == Backpressure::coalesce)
+            {
+                while (queue_.try_pop(evicted))
+                    ++dropped_;
+            }
+
+            while (!queue_.try_push(std::move(event)))
+            {
+                switch (backpressure_)
+                {
+                case Backpressure::block:
+                    wake_worker();
+                    std::this_thread::yield();
+                    break;
+                case Backpressure::drop_oldest:
+                    if (queue_.try_pop(evicted))
+                        ++dropped_;
+                    break;
+                case Backpressure::coalesce:
+                    while (queue_.try_pop(evicted))
+                        ++dropped_;
+                    break;
+                }
+            }
+
+            const std::size_t depth = queue_.size();
+            if (depth > max_queue_depth_.load(std::memory_order_relaxed))
+                max_queue_depth_.store(depth, std::memory_order_relaxed);
+
+            wake_worker();
+        }
+
+        // Events not delivered yet are dropped - the one being delivered is finished
+        void discard_pending()
+        {
+            discarding_ = true;
+        }
+
+        void flush()
+        {
+            while (delivered_.load() + dropped_.load() < pushed_)
+                std::this_thread::yield();
+        }
+
+        DeliveryStats stats() const
+        {
+            const std::size_t delivered = delivered_.load();
+            const auto total_latency = total_latency_ns_.load();
+
+            return DeliveryStats{delivered, dropped_.load(), queue_.size(), max_queue_depth_.load(),
+                std::chrono::nanoseconds{delivered ? total_latency / static_cast<std::int64_t>(delivered) : 0},
+                std::chrono::nanoseconds{max_latency_ns_.load()}};
+        }
+
+    private:
+        void wake_worker()
+        {
+            // pairs with the fence in run() - either the worker sees the event or we see it sleeping
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleeping_.load())
+            {
+                std::lock_guard lk{wake_mutex_};
+                wake_.notify_one();
+            }
+        }
+
+        void run()
+        {
+            Event event;
+
+            while (true)
+            {
+                if (queue_.try_pop(event))
+                {
+                    deliver(event);
+                    continue;
+                }
+
+                if (stopping_)
+                {
+                    if (queue_.try_pop(event))
+                    {
+                        deliver(event);
+                        continue;
+                    }
+                    break;
+                }
+
+                std::unique_lock lk{wake_mutex_};
+                sleeping_ = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wake_.wait(lk, [this] { return queue_.size() > 0 || stopping_; });
+                sleeping_ = false;
+            }
+        }
+
+        void deliver(Event& event)
+        {
+            if (discarding_)
+            {
+                ++dropped_;
+                return;
+            }
+
+            const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - event.notified_at).count();
+            total_latency_ns_.fetch_add(latency, std::memory_order_relaxed);
+            if (latency > max_latency_ns_.load(std::memory_order_relaxed))
+                max_latency_ns_.store(latency, std::memory_order_relaxed);
+
+            std::apply([this, &event](auto&... args) { observer_->update(*event.source, args...); }, event.args);
+
+            delivered_.fetch_add(1);
+        }
+    };
+
+    std::vector<std::unique_ptr<Channel>> channels_;
+};
+
+#endif /*ASYNC_OBSERVER_HPP_*/
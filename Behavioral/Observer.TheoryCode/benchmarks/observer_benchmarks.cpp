@@ -0,0 +1,142 @@
+#include "observer.hpp"
+#include "static_observer.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    class Sensor : public Observable<Sensor, double>
+    {
+    public:
+        void set_value(double value)
+        {
+            notify(*this, value);
+        }
+    };
+
+    class SummingObserver : public Observer<Sensor, double>
+    {
+    public:
+        double sum = 0.0;
+
+        void update(Sensor&, double value) override
+        {
+            sum += value;
+        }
+    };
+
+    // Previous implementation of Observable - kept as a baseline
+    class SetBasedSensor
+    {
+        std::set<Observer<Sensor, double>*> observers_;
+        Sensor source_;
+
+    public:
+        void subscribe(Observer<Sensor, double>* observer)
+        {
+            observers_.insert(observer);
+        }
+
+        void set_value(double value)
+        {
+            for (auto* observer : observers_)
+                observer->update(source_, value);
+        }
+    };
+
+    template <std::size_t, typename T>
+    using Repeat = T;
+
+    // Observer list fixed at compile time - N times SummingObserver
+    template <typename TIndexes>
+    class StaticSensor;
+
+    template <std::size_t... Indexes>
+    class StaticSensor<std::index_sequence<Indexes...>> : public StaticObservable<Repeat<Indexes, SummingObserver>...>
+    {
+        Sensor source_;
+
+    public:
+        explicit StaticSensor(std::vector<SummingObserver>& observers)
+            : StaticObservable<Repeat<Indexes, SummingObserver>...>{observers[Indexes]...}
+        {
+        }
+
+        void set_value(double value)
+        {
+            this->notify(source_, value);
+        }
+    };
+}
+
+static void BM_Observable_Notify(benchmark::State& state)
+{
+    std::vector<SummingObserver> observers(static_cast<std::size_t>(state.range(0)));
+    Sensor sensor;
+    for (auto& observer : observers)
+        sensor.subscribe(&observer);
+
+    for (auto _ : state)
+    {
+        sensor.set_value(1.0);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Observable_Notify)->RangeMultiplier(10)->Range(1, 100'000);
+
+static void BM_SetBasedObservable_Notify(benchmark::State& state)
+{
+    std::vector<SummingObserver> observers(static_cast<std::size_t>(state.range(0)));
+    SetBasedSensor sensor;
+    for (auto& observer : observers)
+        sensor.subscribe(&observer);
+
+    for (auto _ : state)
+    {
+        sensor.set_value(1.0);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SetBasedObservable_Notify)->RangeMultiplier(10)->Range(1, 100'000);
+
+template <std::size_t N>
+static void BM_StaticObservable_Notify(benchmark::State& state)
+{
+    std::vector<SummingObserver> observers(N);
+    StaticSensor<std::make_index_sequence<N>> sensor{observers};
+
+    for (auto _ : state)
+    {
+        sensor.set_value(1.0);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK_TEMPLATE(BM_StaticObservable_Notify, 1);
+BENCHMARK_TEMPLATE(BM_StaticObservable_Notify, 10);
+BENCHMARK_TEMPLATE(BM_StaticObservable_Notify, 100);
+
+static void BM_Observable_SubscribeUnsubscribe(benchmark::State& state)
+{
+    std::vector<SummingObserver> observers(static_cast<std::size_t>(state.range(0)));
+    Sensor sensor;
+    for (auto& observer : observers)
+        sensor.subscribe(&observer);
+
+    SummingObserver extra;
+    for (auto _ : state)
+    {
+        auto handle = sensor.subscribe(&extra);
+        sensor.unsubscribe(handle);
+    }
+}
+BENCHMARK(BM_Observable_SubscribeUnsubscribe)->RangeMultiplier(10)->Range(1, 100'000);
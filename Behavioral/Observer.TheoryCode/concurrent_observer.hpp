@@ -0,0 +1,188 @@
+#ifndef CONCURRENT_OBSERVER_HPP_
+#define CONCURRENT_OBSERVER_HPP_
+
+#include "observer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+    // Number of notify() calls of all ConcurrentObservables in progress on the calling thread
+    inline unsigned& read_section_depth()
+    {
+        static thread_local unsigned depth = 0;
+        return depth;
+    }
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Observable that can be used from many threads at once.
+//
+// notify() reads an immutable snapshot of the subscriber list without taking any lock.
+// subscribe()/unsubscribe() are serialized by a mutex: they publish a modified copy of the
+// snapshot and then wait until every notify() that could still see the previous one has finished
+// (RCU-style grace period). When unsubscribe() returns, no thread can call the removed observer
+// any more, so it can be safely destroyed.
+//
+// Called from inside update() of any ConcurrentObservable, subscribe()/unsubscribe() do not wait
+// for the grace period - it could wait for the calling notification, or for a thread waiting for
+// it in turn (observers of two observables unsubscribing from each other). The change is
+// published immediately, but notifications in progress may still reach the removed observer.
+template <typename TSource, typename... TEventArgs>
+class ConcurrentObservable
+{
+public:
+    using ObserverType = Observer<TSource, TEventArgs...>;
+
+    ConcurrentObservable() : snapshot_{new Snapshot{}}
+    {
+    }
+
+    ConcurrentObservable(const ConcurrentObservable&) = delete;
+    ConcurrentObservable& operator=(const ConcurrentObservable&) = delete;
+
+    ~ConcurrentObservable()
+    {
+        delete snapshot_.load();
+    }
+
+    void subscribe(ObserverType* observer)
+    {
+        {
+            std::lock_guard lk{writer_mutex_};
+
+            auto next = std::make_unique<Snapshot>(*snapshot_.load());
+            next->push_back(observer);
+            publish(std::move(next));
+        }
+
+        synchronize();
+    }
+
+    void unsubscribe(ObserverType* observer)
+    {
+        {
+            std::lock_guard lk{writer_mutex_};
+
+            const Snapshot& current = *snapshot_.load();
+            if (std::find(current.begin(), current.end(), observer) == current.end())
+                return;
+
+            auto next = std::make_unique<Snapshot>();
+            next->reserve(current.size() - 1);
+            std::copy_if(current.begin(), current.end(), std::back_inserter(*next), [observer](ObserverType* o) { return o != observer; });
+            publish(std::move(next));
+        }
+
+        synchronize();
+    }
+
+protected:
+    void notify(TSource& source, EventParam<TEventArgs>... args)
+    {
+        ReadSection section{*this};
+
+        for (ObserverType* observer : *section.snapshot())
+            observer->update(source, args...);
+    }
+
+private:
+    using Snapshot = std::vector<ObserverType*>;
+
+    struct alignas(64) ReaderCount
+    {
+        std::atomic<std::size_t> value{0};
+    };
+
+    std::atomic<const Snapshot*> snapshot_;
+    std::atomic<unsigned> epoch_{0};
+    ReaderCount readers_[2];
+
+    std::mutex writer_mutex_; // serializes changes of the snapshot
+    std::mutex grace_mutex_;  // serializes epoch flips
+    std::vector<std::unique_ptr<const Snapshot>> retired_;
+
+    // Registers a reader in the current epoch. A writer flips the epoch after publishing a new
+    // snapshot and waits for the readers of the previous epoch - they are the only ones that
+    // may still use the snapshot it replaced.
+    class ReadSection
+    {
+        ConcurrentObservable& observable_;
+        unsigned epoch_;
+        const Snapshot* snapshot_;
+
+    public:
+        explicit ReadSection(ConcurrentObservable& observable) : observable_{observable}
+        {
+            while (true)
+            {
+                epoch_ = observable_.epoch_.load();
+                observable_.readers_[epoch_].value.fetch_add(1);
+
+                if (observable_.epoch_.load() == epoch_)
+                    break;
+
+                observable_.readers_[epoch_].value.fetch_sub(1);
+            }
+
+            snapshot_ = observable_.snapshot_.load();
+            ++detail::read_section_depth();
+        }
+
+        ReadSection(const ReadSection&) = delete;
+        ReadSection& operator=(const ReadSection&) = delete;
+
+        ~ReadSection()
+        {
+            --detail::read_section_depth();
+            observable_.readers_[epoch_].value.fetch_sub(1);
+        }
+
+        const Snapshot* snapshot() const
+        {
+            return snapshot_;
+        }
+
+        // true if the calling thread is inside notify() of any ConcurrentObservable
+        static bool is_active()
+        {
+            return detail::read_section_depth() != 0;
+        }
+    };
+
+    // writer_mutex_ must be held
+    void publish(std::unique_ptr<Snapshot> next)
+    {
+        retired_.emplace_back(snapshot_.exchange(next.release()));
+    }
+
+    // Waits for the grace period and frees snapshots retired so far. Called without writer_mutex_,
+    // so observers of a notification being waited for can still subscribe and unsubscribe.
+    void synchronize()
+    {
+        if (ReadSection::is_active())
+            return; // reclaimed by the next change made outside of notification
+
+        std::lock_guard grace_lk{grace_mutex_};
+
+        std::vector<std::unique_ptr<const Snapshot>> retired;
+        {
+            std::lock_guard lk{writer_mutex_};
+            retired.swap(retired_);
+        }
+
+        const unsigned previous_epoch = epoch_.load();
+        epoch_.store(previous_epoch ^ 1u);
+
+        while (readers_[previous_epoch].value.load() != 0)
+            std::this_thread::yield();
+    }
+};
+
+#endif /*CONCURRENT_OBSERVER_HPP_*/
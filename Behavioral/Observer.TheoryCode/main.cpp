@@ -101,4 +101,11 @@ int main()
     temp_monitor.set_temperature(24.0);
     temp_monitor.set_temperature(23.0);
     temp_monitor.set_temperature(21.0);
+
+#ifdef OBSERVER_ENABLE_PROFILING
+    std::cout << "\nTemperatureMonitor observers:\n";
+    temp_monitor.dump_profile(std::cout);
+    std::cout << "\nFan observers:\n";
+    fan.dump_profile(std::cout);
+#endif
 }
@@ -1,9 +1,19 @@
 #ifndef OBSERVER_HPP_
 #define OBSERVER_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <set>
+#include <limits>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef OBSERVER_ENABLE_PROFILING
+#include "observer_profiler.hpp"
+#endif
 
 //////////////////////////////////////////////////////////////////////////////////////
 template <typename TSource, typename... TEventArgs>
@@ -15,25 +25,340 @@ public:
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
+// Parameter type of notify() for an event argument. Arguments declared as references are passed
+// through, the others are taken by const reference - notify() never copies an argument and every
+// observer gets the same object. Large payloads should be declared as const T&, otherwise
+// update() receives its own copy.
+template <typename TEventArg>
+using EventParam = std::conditional_t<std::is_reference_v<TEventArg>, TEventArg, const TEventArg&>;
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Returned by Observable::subscribe - allows unsubscribing in O(1).
+// Slots are reused; the generation makes a handle of an earlier subscription of the slot stale,
+// so unsubscribing twice never removes someone else's subscription.
+struct SubscriptionHandle
+{
+    std::size_t slot;
+    std::uint32_t generation; // 0 - never a valid subscription
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Interface through which ScopedSubscription reaches its observable
+class SubscriptionOwner
+{
+public:
+    virtual void unsubscribe(SubscriptionHandle handle) = 0;
+    virtual bool is_subscribed(SubscriptionHandle handle) const = 0;
+
+protected:
+    ~SubscriptionOwner() = default;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// RAII subscription - unsubscribes when destroyed. Typically a member of the observer, so an
+// observer cannot outlive its subscription. The observable is referenced weakly: if it is
+// destroyed first, the subscription simply becomes disconnected.
+class ScopedSubscription
+{
+    std::weak_ptr<SubscriptionOwner> owner_;
+    SubscriptionHandle handle_{};
+
+public:
+    ScopedSubscription() = default;
+
+    ScopedSubscription(std::weak_ptr<SubscriptionOwner> owner, SubscriptionHandle handle)
+        : owner_{std::move(owner)}, handle_{handle}
+    {
+    }
+
+    ScopedSubscription(const ScopedSubscription&) = delete;
+    ScopedSubscription& operator=(const ScopedSubscription&) = delete;
+
+    ScopedSubscription(ScopedSubscription&& other) noexcept
+        : owner_{std::move(other.owner_)}, handle_{std::exchange(other.handle_, SubscriptionHandle{})}
+    {
+    }
+
+    ScopedSubscription& operator=(ScopedSubscription&& other) noexcept
+    {
+        if (this != &other)
+        {
+            disconnect();
+            owner_ = std::move(other.owner_);
+            handle_ = std::exchange(other.handle_, SubscriptionHandle{});
+        }
+        return *this;
+    }
+
+    ~ScopedSubscription()
+    {
+        disconnect();
+    }
+
+    void disconnect()
+    {
+        if (auto owner = owner_.lock())
+            owner->unsubscribe(handle_);
+
+        owner_.reset();
+        handle_ = SubscriptionHandle{};
+    }
+
+    // Leaves the observer subscribed - it has to be unsubscribed with the returned handle
+    SubscriptionHandle release()
+    {
+        owner_.reset();
+        return std::exchange(handle_, SubscriptionHandle{});
+    }
+
+    bool is_connected() const
+    {
+        auto owner = owner_.lock();
+        return owner && owner->is_subscribed(handle_);
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Observers are kept in a contiguous vector - notify walks an array and subscribe allocates
+// only when the vector grows. Unsubscribing by handle is an O(1) swap-remove.
+// Subscribing and unsubscribing from inside update() is allowed: observers added during
+// notification are not notified by it, removed ones are skipped and compacted afterwards.
+// Observables cannot be copied - subscriptions (and their handles) belong to one object.
+//
+// Defining OBSERVER_ENABLE_PROFILING makes notify() measure every update() call - see profile().
+// Without it the instrumentation is compiled out.
 template <typename TSource, typename... TEventArgs>
 struct Observable
 {
-    void subscribe(Observer<TSource, TEventArgs...>* observer)
-    {        
-        observers_.insert(observer);
+    using ObserverType = Observer<TSource, TEventArgs...>;
+
+    Observable() : owner_{std::make_shared<Owner>(*this)}
+    {
+    }
+
+    Observable(const Observable&) = delete;
+    Observable& operator=(const Observable&) = delete;
+
+    SubscriptionHandle subscribe(ObserverType* observer)
+    {
+        std::size_t slot;
+        if (!free_slots_.empty())
+        {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        else
+        {
+            slot = positions_.size();
+            positions_.push_back(npos);
+            generations_.push_back(1);
+#ifdef OBSERVER_ENABLE_PROFILING
+            profiles_.emplace_back();
+#endif
+        }
+
+#ifdef OBSERVER_ENABLE_PROFILING
+        profiles_[slot] = ObserverProfile{};
+#endif
+
+        positions_[slot] = observers_.size();
+        observers_.push_back(observer);
+        slots_.push_back(slot);
+
+        return SubscriptionHandle{slot, generations_[slot]};
     }
-    
-    void unsubscribe(Observer<TSource, TEventArgs...>* observer) { observers_.erase(observer); }
+
+    // Unsubscribes automatically when the returned object is destroyed
+    [[nodiscard]] ScopedSubscription subscribe_scoped(ObserverType* observer)
+    {
+        return ScopedSubscription{owner_, subscribe(observer)};
+    }
+
+    bool is_subscribed(SubscriptionHandle handle) const
+    {
+        return handle.slot < positions_.size() && positions_[handle.slot] != npos && generations_[handle.slot] == handle.generation;
+    }
+
+    // Stale handles (already unsubscribed, possibly with the slot reused) are ignored
+    void unsubscribe(SubscriptionHandle handle)
+    {
+        if (!is_subscribed(handle))
+            return;
+
+        const std::size_t position = positions_[handle.slot];
+        positions_[handle.slot] = npos;
+        if (++generations_[handle.slot] == 0)
+            generations_[handle.slot] = 1;
+        free_slots_.push_back(handle.slot);
+
+        if (notification_depth_ > 0)
+        {
+            observers_[position] = nullptr;
+            has_removed_observers_ = true;
+        }
+        else
+        {
+            remove_at(position);
+        }
+    }
+
+    // O(n) - prefer unsubscribing with the handle returned by subscribe
+    void unsubscribe(ObserverType* observer)
+    {
+        if (observer == nullptr)
+            return;
+
+        for (std::size_t i = 0; i < observers_.size(); ++i)
+        {
+            if (observers_[i] == observer)
+            {
+                unsubscribe(SubscriptionHandle{slots_[i], generations_[slots_[i]]});
+                return;
+            }
+        }
+    }
+
+#ifdef OBSERVER_ENABLE_PROFILING
+    // Statistics of the current subscribers, collected since they subscribed (or since reset_profile())
+    std::vector<ObserverProfileEntry<ObserverType>> profile() const
+    {
+        std::vector<ObserverProfileEntry<ObserverType>> entries;
+        for (std::size_t i = 0; i < observers_.size(); ++i)
+        {
+            if (observers_[i])
+                entries.push_back({observers_[i], profiles_[slots_[i]]});
+        }
+        return entries;
+    }
+
+    void dump_profile(std::ostream& out) const
+    {
+        ::dump_profile(out, profile());
+    }
+
+    void reset_profile()
+    {
+        std::fill(profiles_.begin(), profiles_.end(), ObserverProfile{});
+    }
+#endif
 
 protected:
-    void notify(TSource& source, TEventArgs... args)
+    void notify(TSource& source, EventParam<TEventArgs>... args)
     {
-        for (auto&& observer : observers_)
-            observer->update(static_cast<TSource&>(*this), std::move(args...));
+        NotificationScope scope{*this};
+
+        const std::size_t count = observers_.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (ObserverType* observer = observers_[i])
+            {
+#ifdef OBSERVER_ENABLE_PROFILING
+                const SubscriptionHandle handle{slots_[i], generations_[slots_[i]]};
+                const auto start = ObserverProfile::Clock::now();
+                observer->update(source, args...);
+                const auto latency = ObserverProfile::Clock::now() - start;
+
+                if (generations_[handle.slot] == handle.generation) // not unsubscribed in update()
+                    profiles_[handle.slot].record(latency);
+#else
+                observer->update(source, args...); // never moved from - every observer sees the same arguments
+#endif
+            }
+        }
     }
 
 private:
-    std::set<Observer<TSource, TEventArgs...>*> observers_;
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    std::vector<ObserverType*> observers_;
+    std::vector<std::size_t> slots_;     // slot of the observer at the same position
+    std::vector<std::size_t> positions_; // position of the observer in a slot (npos if free)
+    std::vector<std::uint32_t> generations_; // bumped when a slot is freed
+#ifdef OBSERVER_ENABLE_PROFILING
+    std::vector<ObserverProfile> profiles_; // per slot
+#endif
+    std::vector<std::size_t> free_slots_;
+    int notification_depth_ = 0;
+    bool has_removed_observers_ = false;
+
+    class Owner : public SubscriptionOwner
+    {
+        Observable& observable_;
+
+    public:
+        explicit Owner(Observable& observable) : observable_{observable}
+        {
+        }
+
+        void unsubscribe(SubscriptionHandle handle) override
+        {
+            observable_.unsubscribe(handle);
+        }
+
+        bool is_subscribed(SubscriptionHandle handle) const override
+        {
+            return observable_.is_subscribed(handle);
+        }
+    };
+
+    std::shared_ptr<Owner> owner_; // scoped subscriptions hold it weakly
+
+    class NotificationScope
+    {
+        Observable& observable_;
+
+    public:
+        explicit NotificationScope(Observable& observable) : observable_{observable}
+        {
+            ++observable_.notification_depth_;
+        }
+
+        NotificationScope(const NotificationScope&) = delete;
+        NotificationScope& operator=(const NotificationScope&) = delete;
+
+        ~NotificationScope()
+        {
+            if (--observable_.notification_depth_ == 0 && observable_.has_removed_observers_)
+                observable_.remove_unsubscribed();
+        }
+    };
+
+    void remove_at(std::size_t position)
+    {
+        const std::size_t last = observers_.size() - 1;
+        if (position != last)
+        {
+            observers_[position] = observers_[last];
+            slots_[position] = slots_[last];
+            positions_[slots_[position]] = position;
+        }
+        observers_.pop_back();
+        slots_.pop_back();
+    }
+
+    void remove_unsubscribed()
+    {
+        std::size_t position = 0;
+        while (position < observers_.size())
+        {
+            if (observers_[position] != nullptr)
+            {
+                ++position;
+                continue;
+            }
+
+            // slots of removed observers may already be reused - only live observers can be moved
+            while (!observers_.empty() && observers_.back() == nullptr)
+            {
+                observers_.pop_back();
+                slots_.pop_back();
+            }
+
+            if (position < observers_.size())
+                remove_at(position);
+        }
+        has_removed_observers_ = false;
+    }
 };
 
 #endif /*OBSERVER_HPP_*/
@@ -0,0 +1,89 @@
+#ifndef OBSERVER_PROFILER_HPP_
+#define OBSERVER_PROFILER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Notification statistics of one observer. Latencies are inclusive - if update() notifies other
+// observers (e.g. Fan forwarding to ConsoleLogger), their time is counted too.
+struct ObserverProfile
+{
+    using Clock = std::chrono::steady_clock;
+
+    // bucket i counts calls that took [2^(i-1), 2^i) ns - bucket 0 is under 1 ns
+    static constexpr std::size_t bucket_count = 48;
+
+    std::size_t calls = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    std::array<std::size_t, bucket_count> histogram{};
+
+    void record(std::chrono::nanoseconds latency)
+    {
+        ++calls;
+        total += latency;
+        if (latency > max)
+            max = latency;
+
+        std::size_t bucket = 0;
+        for (auto ns = static_cast<std::uint64_t>(latency.count()); ns != 0 && bucket < bucket_count - 1; ns >>= 1)
+            ++bucket;
+        ++histogram[bucket];
+    }
+
+    std::chrono::nanoseconds average() const
+    {
+        return calls ? total / static_cast<std::chrono::nanoseconds::rep>(calls) : std::chrono::nanoseconds{0};
+    }
+
+    // Upper bound of the histogram bucket containing the given fraction (0.0 - 1.0) of calls
+    std::chrono::nanoseconds percentile(double fraction) const
+    {
+        const auto rank = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(fraction * calls)));
+        std::size_t count = 0;
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket)
+        {
+            count += histogram[bucket];
+            if (count >= rank)
+                return std::chrono::nanoseconds{std::int64_t{1} << bucket};
+        }
+        return max;
+    }
+};
+
+template <typename TObserver>
+struct ObserverProfileEntry
+{
+    TObserver* observer;
+    ObserverProfile profile;
+};
+
+// Prints one line per observer, most expensive (by total time) first
+template <typename TObserver>
+void dump_profile(std::ostream& out, std::vector<ObserverProfileEntry<TObserver>> entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.profile.total > b.profile.total; });
+
+    out << std::left << std::setw(40) << "observer" << std::right << std::setw(12) << "calls" << std::setw(14) << "total [ns]"
+        << std::setw(10) << "avg" << std::setw(10) << "p50<=" << std::setw(10) << "p99<=" << std::setw(12) << "max" << "\n";
+
+    for (const auto& [observer, profile] : entries)
+    {
+        out << std::left << std::setw(40) << typeid(*observer).name() << std::right << std::setw(12) << profile.calls
+            << std::setw(14) << profile.total.count() << std::setw(10) << profile.average().count()
+            << std::setw(10) << profile.percentile(0.5).count() << std::setw(10) << profile.percentile(0.99).count()
+            << std::setw(12) << profile.max.count() << "\n";
+    }
+}
+
+#endif /*OBSERVER_PROFILER_HPP_*/
@@ -0,0 +1,47 @@
+#ifndef STATIC_OBSERVER_HPP_
+#define STATIC_OBSERVER_HPP_
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Observable for event graphs fixed at build time - the observers are a list of types, bound to
+// objects when the observable is constructed. notify() expands to a sequence of direct calls
+// (no container, no virtual dispatch), so the compiler can inline every update().
+//
+// Observers are called as exactly the listed types: update() is called with a qualified name,
+// so an override in a class derived from a listed type is not used. Observers do not have to
+// derive from Observer - any type with a matching update() works.
+template <typename... TObservers>
+class StaticObservable
+{
+    std::tuple<TObservers&...> observers_;
+
+public:
+    explicit StaticObservable(TObservers&... observers) : observers_{observers...}
+    {
+    }
+
+    static constexpr std::size_t observer_count()
+    {
+        return sizeof...(TObservers);
+    }
+
+protected:
+    // Observers are notified in the order of the list
+    template <typename TSource, typename... TEventArgs>
+    void notify(TSource& source, const TEventArgs&... args)
+    {
+        notify_all(source, std::index_sequence_for<TObservers...>{}, args...);
+    }
+
+private:
+    template <typename TSource, std::size_t... Indexes, typename... TEventArgs>
+    void notify_all(TSource& source, std::index_sequence<Indexes...>, const TEventArgs&... args)
+    {
+        (std::get<Indexes>(observers_).TObservers::update(source, args...), ...);
+    }
+};
+
+#endif /*STATIC_OBSERVER_HPP_*/
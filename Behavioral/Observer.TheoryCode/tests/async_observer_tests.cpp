@@ -0,0 +1,198 @@
+#include "async_observer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class Ticker : public AsyncObservable<Ticker, int, const std::string&>
+    {
+    public:
+        void tick(int value)
+        {
+            notify(*this, value, std::to_string(value));
+        }
+    };
+
+    // Delivers pending events before its part of the source is destroyed
+    class StoppingTicker : public Ticker
+    {
+    public:
+        ~StoppingTicker()
+        {
+            stop();
+        }
+    };
+
+    // Blocks inside the first update until released - simulates a slow observer
+    class SlowObserver : public Observer<Ticker, int, const std::string&>
+    {
+    public:
+        std::vector<int> values;
+        std::vector<std::string> texts;
+        std::atomic<bool> entered{false};
+        std::atomic<bool> released{false};
+
+        void update(Ticker&, int value, const std::string& text) override
+        {
+            entered = true;
+            while (!released)
+                std::this_thread::yield();
+
+            values.push_back(value);
+            texts.push_back(text);
+        }
+
+        void wait_until_entered() const
+        {
+            while (!entered)
+                std::this_thread::yield();
+        }
+    };
+}
+
+TEST_CASE("AsyncObservable delivers events in order", "[observer][async]")
+{
+    Ticker ticker;
+    SlowObserver first, second;
+    first.released = true;
+    second.released = true;
+
+    ticker.subscribe(&first);
+    ticker.subscribe(&second, AsyncOptions{4, Backpressure::block});
+
+    for (int i = 0; i < 100; ++i)
+        ticker.tick(i);
+    ticker.flush();
+
+    std::vector<int> expected(100);
+    for (int i = 0; i < 100; ++i)
+        expected[i] = i;
+
+    REQUIRE(first.values == expected);
+    REQUIRE(second.values == expected);
+    REQUIRE(second.texts.back() == "99");
+
+    auto stats = ticker.stats(&second);
+    REQUIRE(stats.delivered == 100);
+    REQUIRE(stats.dropped == 0);
+    REQUIRE(stats.max_queue_depth <= 4);
+}
+
+TEST_CASE("AsyncObservable backpressure policies", "[observer][async]")
+{
+    Ticker ticker;
+    SlowObserver observer;
+
+    SECTION("drop oldest keeps the newest events")
+    {
+        ticker.subscribe(&observer, AsyncOptions{8, Backpressure::drop_oldest});
+
+        ticker.tick(0);
+        observer.wait_until_entered(); // the worker is stuck in update(0), the queue is empty
+
+        for (int i = 1; i <= 13; ++i)
+            ticker.tick(i);
+
+        observer.released = true;
+        ticker.flush();
+
+        REQUIRE(observer.values == std::vector{0, 6, 7, 8, 9, 10, 11, 12, 13});
+        REQUIRE(ticker.stats(&observer).dropped == 5);
+        REQUIRE(ticker.stats(&observer).max_queue_depth == 8);
+    }
+
+    SECTION("coalesce collapses pending events to the newest one")
+    {
+        ticker.subscribe(&observer, AsyncOptions{4, Backpressure::coalesce});
+
+        ticker.tick(0);
+        observer.wait_until_entered();
+
+        for (int i = 1; i <= 5; ++i)
+            ticker.tick(i);
+
+        observer.released = true;
+        ticker.flush();
+
+        REQUIRE(observer.values == std::vector{0, 5});
+        REQUIRE(ticker.stats(&observer).dropped == 4);
+    }
+
+    SECTION("coalesce delivers only the newest event even if the queue is not full")
+    {
+        ticker.subscribe(&observer, AsyncOptions{1024, Backpressure::coalesce});
+
+        ticker.tick(0);
+        observer.wait_until_entered();
+
+        for (int i = 1; i <= 100; ++i)
+            ticker.tick(i);
+
+        observer.released = true;
+        ticker.flush();
+
+        REQUIRE(observer.values == std::vector{0, 100});
+        REQUIRE(ticker.stats(&observer).dropped == 99);
+        REQUIRE(ticker.stats(&observer).max_queue_depth == 1);
+    }
+}
+
+TEST_CASE("AsyncObservable delivers pending events on unsubscribe", "[observer][async]")
+{
+    Ticker ticker;
+    SlowObserver observer;
+    observer.released = true;
+
+    ticker.subscribe(&observer);
+    for (int i = 0; i < 10; ++i)
+        ticker.tick(i);
+
+    ticker.unsubscribe(&observer);
+    ticker.tick(10);
+
+    REQUIRE(observer.values.size() == 10);
+}
+
+TEST_CASE("AsyncObservable delivers pending events when stopped by the derived destructor", "[observer][async]")
+{
+    SlowObserver observer;
+
+    {
+        StoppingTicker ticker;
+        ticker.subscribe(&observer);
+        for (int i = 0; i < 10; ++i)
+            ticker.tick(i);
+
+        observer.wait_until_entered();
+        observer.released = true;
+    }
+
+    REQUIRE(observer.values.size() == 10);
+}
+
+TEST_CASE("AsyncObservable drops pending events when not stopped before destruction", "[observer][async]")
+{
+    SlowObserver observer;
+    std::thread releaser;
+
+    {
+        Ticker ticker;
+        ticker.subscribe(&observer);
+        for (int i = 0; i < 10; ++i)
+            ticker.tick(i);
+
+        observer.wait_until_entered();
+        releaser = std::thread{[&observer] {
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+            observer.released = true;
+        }};
+    } // waits for the update in progress
+
+    releaser.join();
+    REQUIRE(observer.values == std::vector{0});
+}
@@ -0,0 +1,170 @@
+#include "concurrent_observer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class SharedSensor : public ConcurrentObservable<SharedSensor, int>
+    {
+    public:
+        void set_value(int value)
+        {
+            notify(*this, value);
+        }
+    };
+
+    class GuardedObserver : public Observer<SharedSensor, int>
+    {
+    public:
+        std::atomic<bool> unsubscribed{false};
+        std::atomic<int> calls{0};
+        std::atomic<int>& calls_after_unsubscribe;
+
+        explicit GuardedObserver(std::atomic<int>& violations) : calls_after_unsubscribe{violations}
+        {
+        }
+
+        void update(SharedSensor&, int) override
+        {
+            if (unsubscribed)
+                ++calls_after_unsubscribe;
+            ++calls;
+        }
+    };
+}
+
+TEST_CASE("ConcurrentObservable notifies subscribed observers", "[observer][concurrent]")
+{
+    std::atomic<int> violations{0};
+    SharedSensor sensor;
+    GuardedObserver first{violations}, second{violations};
+
+    sensor.subscribe(&first);
+    sensor.subscribe(&second);
+    sensor.set_value(1);
+
+    sensor.unsubscribe(&first);
+    sensor.set_value(2);
+
+    REQUIRE(first.calls == 1);
+    REQUIRE(second.calls == 2);
+}
+
+TEST_CASE("ConcurrentObservable allows changing subscriptions inside update", "[observer][concurrent]")
+{
+    class SelfRemovingObserver : public Observer<SharedSensor, int>
+    {
+    public:
+        int calls = 0;
+
+        void update(SharedSensor& sensor, int) override
+        {
+            ++calls;
+            sensor.unsubscribe(this);
+        }
+    };
+
+    SharedSensor sensor;
+    SelfRemovingObserver observer;
+    sensor.subscribe(&observer);
+
+    sensor.set_value(1);
+    sensor.set_value(2);
+
+    REQUIRE(observer.calls == 1);
+}
+
+TEST_CASE("ConcurrentObservables unsubscribing from each other inside update do not deadlock", "[observer][concurrent]")
+{
+    // Both threads are inside notify() when each unsubscribes from the other observable
+    class CrossUnsubscriber : public Observer<SharedSensor, int>
+    {
+        SharedSensor& other_;
+        Observer<SharedSensor, int>* removed_;
+        std::atomic<int>& arrived_;
+
+    public:
+        CrossUnsubscriber(SharedSensor& other, Observer<SharedSensor, int>* removed, std::atomic<int>& arrived)
+            : other_{other}, removed_{removed}, arrived_{arrived}
+        {
+        }
+
+        void update(SharedSensor&, int) override
+        {
+            ++arrived_;
+            while (arrived_ < 2)
+                std::this_thread::yield();
+
+            other_.unsubscribe(removed_);
+        }
+    };
+
+    std::atomic<int> violations{0};
+    std::atomic<int> arrived{0};
+    SharedSensor first, second;
+    GuardedObserver first_removed{violations}, second_removed{violations};
+    CrossUnsubscriber first_unsubscriber{second, &second_removed, arrived};
+    CrossUnsubscriber second_unsubscriber{first, &first_removed, arrived};
+
+    first.subscribe(&first_unsubscriber);
+    first.subscribe(&first_removed);
+    second.subscribe(&second_unsubscriber);
+    second.subscribe(&second_removed);
+
+    std::thread other{[&] { second.set_value(1); }};
+    first.set_value(1);
+    other.join();
+
+    const int first_calls = first_removed.calls;
+    const int second_calls = second_removed.calls;
+    first.set_value(2);
+    second.set_value(2);
+
+    REQUIRE(first_removed.calls == first_calls);
+    REQUIRE(second_removed.calls == second_calls);
+}
+
+TEST_CASE("ConcurrentObservable never calls an observer after unsubscribe returns", "[observer][concurrent][stress]")
+{
+    const int publisher_count = 4;
+    const int subscription_rounds = 2'000;
+
+    SharedSensor sensor;
+    std::atomic<int> violations{0};
+    std::atomic<bool> done{false};
+
+    GuardedObserver permanent{violations};
+    sensor.subscribe(&permanent);
+
+    std::vector<std::thread> publishers;
+    for (int i = 0; i < publisher_count; ++i)
+    {
+        publishers.emplace_back([&] {
+            int value = 0;
+            while (!done)
+                sensor.set_value(++value);
+        });
+    }
+
+    for (int round = 0; round < subscription_rounds; ++round)
+    {
+        auto observer = std::make_unique<GuardedObserver>(violations);
+        sensor.subscribe(observer.get());
+        std::this_thread::yield();
+        sensor.unsubscribe(observer.get());
+        observer->unsubscribed = true;
+        std::this_thread::yield();
+        observer.reset(); // any later call would be a use-after-free (detected by sanitizers)
+    }
+
+    done = true;
+    for (auto& publisher : publishers)
+        publisher.join();
+
+    REQUIRE(violations == 0);
+    REQUIRE(permanent.calls > 0);
+}
@@ -0,0 +1,107 @@
+// Built as a separate test binary with OBSERVER_ENABLE_PROFILING defined
+#include "observer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+using namespace std::literals;
+
+namespace
+{
+    class Thermometer : public Observable<Thermometer, double>
+    {
+    public:
+        void set_temperature(double temperature)
+        {
+            notify(*this, temperature);
+        }
+    };
+
+    class FastObserver : public Observer<Thermometer, double>
+    {
+    public:
+        void update(Thermometer&, double) override
+        {
+        }
+    };
+
+    class SlowObserver : public Observer<Thermometer, double>
+    {
+    public:
+        void update(Thermometer&, double) override
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+    };
+}
+
+TEST_CASE("ObserverProfile histogram", "[observer][profiling]")
+{
+    ObserverProfile profile;
+    profile.record(0ns);
+    profile.record(1ns);
+    profile.record(100ns);
+    profile.record(1000ns);
+
+    REQUIRE(profile.calls == 4);
+    REQUIRE(profile.total == 1101ns);
+    REQUIRE(profile.max == 1000ns);
+    REQUIRE(profile.histogram[0] == 1);
+    REQUIRE(profile.histogram[1] == 1);
+    REQUIRE(profile.histogram[7] == 1);  // [64, 128)
+    REQUIRE(profile.histogram[10] == 1); // [512, 1024)
+    REQUIRE(profile.percentile(0.5) == 2ns);
+    REQUIRE(profile.percentile(1.0) == 1024ns);
+}
+
+TEST_CASE("Observable records a profile for every observer", "[observer][profiling]")
+{
+    Thermometer thermometer;
+    FastObserver fast;
+    SlowObserver slow;
+
+    thermometer.subscribe(&fast);
+    thermometer.subscribe(&slow);
+
+    for (int i = 0; i < 3; ++i)
+        thermometer.set_temperature(i);
+
+    const auto entries = thermometer.profile();
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].observer == &fast);
+    REQUIRE(entries[0].profile.calls == 3);
+    REQUIRE(entries[1].observer == &slow);
+    REQUIRE(entries[1].profile.calls == 3);
+    REQUIRE(entries[1].profile.max >= 1ms);
+    REQUIRE(entries[1].profile.total > entries[0].profile.total);
+
+    SECTION("dump lists the most expensive observer first")
+    {
+        std::ostringstream out;
+        thermometer.dump_profile(out);
+
+        const std::string text = out.str();
+        REQUIRE(text.find(typeid(SlowObserver).name()) < text.find(typeid(FastObserver).name()));
+    }
+
+    SECTION("reset")
+    {
+        thermometer.reset_profile();
+        REQUIRE(thermometer.profile()[0].profile.calls == 0);
+    }
+
+    SECTION("profile of a reused slot starts from scratch")
+    {
+        thermometer.unsubscribe(&fast);
+        FastObserver other;
+        thermometer.subscribe(&other);
+        thermometer.set_temperature(10);
+
+        const auto after = thermometer.profile();
+        REQUIRE(after.size() == 2);
+        REQUIRE(after[1].observer == &other);
+        REQUIRE(after[1].profile.calls == 1);
+    }
+}
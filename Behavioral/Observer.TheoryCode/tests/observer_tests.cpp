@@ -0,0 +1,363 @@
+#include "observer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+    class Sensor : public Observable<Sensor, int>
+    {
+    public:
+        void set_value(int value)
+        {
+            notify(*this, value);
+        }
+    };
+
+    class RecordingObserver : public Observer<Sensor, int>
+    {
+    public:
+        std::vector<int> values;
+        std::function<void()> on_update;
+
+        void update(Sensor&, int value) override
+        {
+            values.push_back(value);
+            if (on_update)
+                on_update();
+        }
+    };
+}
+
+TEST_CASE("Observable notifies subscribed observers", "[observer]")
+{
+    Sensor sensor;
+    RecordingObserver first, second;
+
+    sensor.subscribe(&first);
+    auto second_handle = sensor.subscribe(&second);
+
+    sensor.set_value(1);
+
+    REQUIRE(first.values == std::vector{1});
+    REQUIRE(second.values == std::vector{1});
+
+    SECTION("unsubscribe with handle")
+    {
+        sensor.unsubscribe(second_handle);
+        sensor.set_value(2);
+
+        REQUIRE(first.values == std::vector{1, 2});
+        REQUIRE(second.values == std::vector{1});
+    }
+
+    SECTION("unsubscribe with pointer")
+    {
+        sensor.unsubscribe(&first);
+        sensor.set_value(2);
+
+        REQUIRE(first.values == std::vector{1});
+        REQUIRE(second.values == std::vector{1, 2});
+    }
+
+    SECTION("unsubscribing twice is harmless")
+    {
+        sensor.unsubscribe(second_handle);
+        sensor.unsubscribe(second_handle);
+        sensor.set_value(2);
+
+        REQUIRE(first.values == std::vector{1, 2});
+    }
+
+    SECTION("stale handle does not remove the subscription reusing its slot")
+    {
+        RecordingObserver third;
+
+        sensor.unsubscribe(second_handle);
+        auto third_handle = sensor.subscribe(&third);
+        REQUIRE(third_handle.slot == second_handle.slot);
+
+        sensor.unsubscribe(second_handle);
+        sensor.set_value(2);
+
+        REQUIRE(sensor.is_subscribed(third_handle));
+        REQUIRE_FALSE(sensor.is_subscribed(second_handle));
+        REQUIRE(third.values == std::vector{2});
+    }
+
+    SECTION("default handle is never subscribed")
+    {
+        REQUIRE_FALSE(sensor.is_subscribed(SubscriptionHandle{}));
+        sensor.unsubscribe(SubscriptionHandle{});
+        sensor.set_value(2);
+
+        REQUIRE(first.values == std::vector{1, 2});
+        REQUIRE(second.values == std::vector{1, 2});
+    }
+}
+
+TEST_CASE("ScopedSubscription unsubscribes when destroyed", "[observer][scoped]")
+{
+    Sensor sensor;
+    RecordingObserver observer;
+
+    {
+        auto subscription = sensor.subscribe_scoped(&observer);
+        REQUIRE(subscription.is_connected());
+
+        sensor.set_value(1);
+    }
+
+    sensor.set_value(2);
+    REQUIRE(observer.values == std::vector{1});
+
+    SECTION("moved subscription stays connected")
+    {
+        ScopedSubscription target;
+        {
+            auto subscription = sensor.subscribe_scoped(&observer);
+            target = std::move(subscription);
+            REQUIRE_FALSE(subscription.is_connected());
+        }
+
+        sensor.set_value(3);
+        REQUIRE(target.is_connected());
+        REQUIRE(observer.values == std::vector{1, 3});
+
+        target.disconnect();
+        sensor.set_value(4);
+        REQUIRE(observer.values == std::vector{1, 3});
+    }
+
+    SECTION("released subscription stays subscribed")
+    {
+        SubscriptionHandle handle;
+        {
+            auto subscription = sensor.subscribe_scoped(&observer);
+            handle = subscription.release();
+        }
+
+        sensor.set_value(3);
+        REQUIRE(observer.values == std::vector{1, 3});
+        REQUIRE(sensor.is_subscribed(handle));
+    }
+
+    SECTION("unsubscribing from inside update")
+    {
+        auto subscription = sensor.subscribe_scoped(&observer);
+        observer.on_update = [&] { subscription.disconnect(); };
+
+        sensor.set_value(3);
+        sensor.set_value(4);
+        REQUIRE(observer.values == std::vector{1, 3});
+    }
+}
+
+TEST_CASE("ScopedSubscription may outlive the observable", "[observer][scoped]")
+{
+    RecordingObserver observer;
+    ScopedSubscription subscription;
+
+    {
+        Sensor sensor;
+        subscription = sensor.subscribe_scoped(&observer);
+        REQUIRE(subscription.is_connected());
+    }
+
+    REQUIRE_FALSE(subscription.is_connected());
+    subscription.disconnect();
+}
+
+namespace
+{
+    // Observer owning its subscription - it cannot be notified after its destruction
+    class SelfUnsubscribingObserver : public RecordingObserver
+    {
+        ScopedSubscription subscription_;
+
+    public:
+        explicit SelfUnsubscribingObserver(Sensor& sensor) : subscription_{sensor.subscribe_scoped(this)}
+        {
+        }
+    };
+}
+
+TEST_CASE("Observer with a ScopedSubscription member", "[observer][scoped]")
+{
+    Sensor sensor;
+    RecordingObserver survivor;
+    sensor.subscribe(&survivor);
+
+    {
+        SelfUnsubscribingObserver temporary{sensor};
+        sensor.set_value(1);
+        REQUIRE(temporary.values == std::vector{1});
+    }
+
+    sensor.set_value(2);
+    REQUIRE(survivor.values == std::vector{1, 2});
+}
+
+TEST_CASE("Observable tolerates changes of subscriptions during notification", "[observer]")
+{
+    Sensor sensor;
+    RecordingObserver first, second, third, late;
+
+    sensor.subscribe(&first);
+    auto second_handle = sensor.subscribe(&second);
+    auto third_handle = sensor.subscribe(&third);
+
+    SECTION("observer unsubscribed by another one is skipped")
+    {
+        first.on_update = [&] { sensor.unsubscribe(third_handle); };
+        second.on_update = [&] { sensor.unsubscribe(second_handle); };
+
+        sensor.set_value(1);
+        sensor.set_value(2);
+
+        REQUIRE(first.values == std::vector{1, 2});
+        REQUIRE(second.values == std::vector{1});
+        REQUIRE(third.values.empty());
+    }
+
+    SECTION("observer subscribed during notification receives only next events")
+    {
+        first.on_update = [&] {
+            if (first.values.size() == 1)
+                sensor.subscribe(&late);
+        };
+
+        sensor.set_value(1);
+        sensor.set_value(2);
+
+        REQUIRE(late.values == std::vector{2});
+    }
+
+    SECTION("slot freed during notification can be reused immediately")
+    {
+        first.on_update = [&] {
+            if (first.values.size() == 1)
+            {
+                sensor.unsubscribe(second_handle);
+                sensor.subscribe(&late);
+            }
+        };
+
+        sensor.set_value(1);
+        sensor.set_value(2);
+
+        REQUIRE(second.values.empty());
+        REQUIRE(third.values == std::vector{1, 2});
+        REQUIRE(late.values == std::vector{2});
+
+        sensor.unsubscribe(third_handle);
+        sensor.set_value(3);
+
+        REQUIRE(first.values == std::vector{1, 2, 3});
+        REQUIRE(third.values == std::vector{1, 2});
+        REQUIRE(late.values == std::vector{2, 3});
+        REQUIRE(second.values.empty());
+    }
+}
+
+namespace
+{
+    class Messenger : public Observable<Messenger, const std::string&, std::string>
+    {
+    public:
+        void send(const std::string& by_reference, const std::string& by_value)
+        {
+            notify(*this, by_reference, by_value);
+        }
+    };
+
+    class MessageObserver : public Observer<Messenger, const std::string&, std::string>
+    {
+    public:
+        const std::string* received_address = nullptr;
+        std::string by_reference;
+        std::string by_value;
+
+        void update(Messenger&, const std::string& reference_arg, std::string value_arg) override
+        {
+            received_address = &reference_arg;
+            by_reference = reference_arg;
+            by_value = std::move(value_arg);
+        }
+    };
+
+    struct Payload
+    {
+        static inline int copies = 0;
+
+        std::vector<int> data;
+
+        explicit Payload(std::size_t size) : data(size)
+        {
+        }
+
+        Payload(const Payload& other) : data{other.data}
+        {
+            ++copies;
+        }
+
+        Payload& operator=(const Payload&) = delete;
+    };
+
+    class PayloadSource : public Observable<PayloadSource, const Payload&>
+    {
+    public:
+        void publish(const Payload& payload)
+        {
+            notify(*this, payload);
+        }
+    };
+
+    class PayloadObserver : public Observer<PayloadSource, const Payload&>
+    {
+    public:
+        const Payload* received = nullptr;
+
+        void update(PayloadSource&, const Payload& payload) override
+        {
+            received = &payload;
+        }
+    };
+}
+
+TEST_CASE("Observable passes the same arguments to every observer", "[observer][payload]")
+{
+    Messenger messenger;
+    std::vector<MessageObserver> observers(100);
+    for (auto& observer : observers)
+        messenger.subscribe(&observer);
+
+    const std::string text(1000, 'x');
+    const std::string other_text = "long enough to be allocated on the heap, not in the SSO buffer";
+    messenger.send(text, other_text);
+
+    for (const auto& observer : observers)
+    {
+        REQUIRE(observer.received_address == &text);
+        REQUIRE(observer.by_reference == text);
+        REQUIRE(observer.by_value == other_text);
+    }
+}
+
+TEST_CASE("Observable does not copy payloads passed by reference", "[observer][payload]")
+{
+    PayloadSource source;
+    std::vector<PayloadObserver> observers(100);
+    for (auto& observer : observers)
+        source.subscribe(&observer);
+
+    const Payload payload{1'000'000};
+    Payload::copies = 0;
+    source.publish(payload);
+
+    REQUIRE(Payload::copies == 0);
+    for (const auto& observer : observers)
+        REQUIRE(observer.received == &payload);
+}
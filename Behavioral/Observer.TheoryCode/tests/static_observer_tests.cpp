@@ -0,0 +1,108 @@
+#include "static_observer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The main.cpp graph wired at compile time: TemperatureMonitor -> Fan -> ConsoleLogger
+    class ConsoleLogger
+    {
+    public:
+        std::vector<std::string> log;
+
+        template <typename TMonitor>
+        void update(TMonitor&, double temperature)
+        {
+            log.push_back("temperature " + std::to_string(static_cast<int>(temperature)));
+        }
+
+        template <typename TFan>
+        void update(TFan&, const std::string& message)
+        {
+            log.push_back(message);
+        }
+    };
+
+    class Fan : public StaticObservable<ConsoleLogger>
+    {
+        bool is_on_ = false;
+
+    public:
+        using StaticObservable::StaticObservable;
+
+        template <typename TMonitor>
+        void update(TMonitor&, double temperature)
+        {
+            if (!is_on_ && temperature > 25.0)
+            {
+                is_on_ = true;
+                notify(*this, std::string{"Fan is on..."});
+            }
+
+            if (is_on_ && temperature < 24.0)
+            {
+                is_on_ = false;
+                notify(*this, std::string{"Fan is off..."});
+            }
+        }
+    };
+
+    class TemperatureMonitor : public StaticObservable<Fan, ConsoleLogger>
+    {
+    public:
+        using StaticObservable::StaticObservable;
+
+        void set_temperature(double temperature)
+        {
+            notify(*this, temperature);
+        }
+    };
+
+    struct Base
+    {
+        int calls = 0;
+
+        void update(int&, int)
+        {
+            ++calls;
+        }
+    };
+}
+
+TEST_CASE("StaticObservable notifies the listed observers in order", "[observer][static]")
+{
+    ConsoleLogger logger;
+    Fan fan{logger};
+    TemperatureMonitor monitor{fan, logger};
+
+    STATIC_REQUIRE(TemperatureMonitor::observer_count() == 2);
+
+    monitor.set_temperature(22.0);
+    monitor.set_temperature(26.0);
+    monitor.set_temperature(23.0);
+
+    REQUIRE(logger.log == std::vector<std::string>{"temperature 22", "Fan is on...", "temperature 26", "Fan is off...", "temperature 23"});
+}
+
+TEST_CASE("StaticObservable may list the same type many times", "[observer][static]")
+{
+    struct Source : StaticObservable<Base, Base, Base>
+    {
+        using StaticObservable::StaticObservable;
+
+        void fire()
+        {
+            int source = 0;
+            notify(source, 1);
+        }
+    };
+
+    Base a, b;
+    Source source{a, b, a};
+    source.fire();
+
+    REQUIRE(a.calls == 2);
+    REQUIRE(b.calls == 1);
+}
@@ -0,0 +1,122 @@
+#include "throttled_observer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    class Thermometer : public ThrottledObservable<Thermometer, double, const std::string&>
+    {
+    public:
+        void set_temperature(Clock::time_point now, double temperature)
+        {
+            notify_at(now, *this, temperature, std::to_string(temperature));
+        }
+    };
+
+    class RecordingObserver : public Observer<Thermometer, double, const std::string&>
+    {
+    public:
+        std::vector<double> values;
+        std::string last_text;
+
+        void update(Thermometer&, double temperature, const std::string& text) override
+        {
+            values.push_back(temperature);
+            last_text = text;
+        }
+    };
+}
+
+TEST_CASE("ThrottledObservable without interval delivers every event", "[observer][throttled]")
+{
+    Thermometer thermometer;
+    RecordingObserver observer;
+    thermometer.subscribe(&observer);
+
+    const auto start = Clock::now();
+    for (int i = 0; i < 5; ++i)
+        thermometer.set_temperature(start, i);
+
+    REQUIRE(observer.values == std::vector<double>{0, 1, 2, 3, 4});
+    REQUIRE_FALSE(thermometer.has_pending());
+}
+
+TEST_CASE("ThrottledObservable coalesces events inside the window", "[observer][throttled]")
+{
+    Thermometer thermometer;
+    RecordingObserver throttled, immediate;
+    thermometer.subscribe(&throttled, 10ms);
+    thermometer.subscribe(&immediate);
+
+    const auto start = Clock::now();
+    for (int i = 0; i < 1000; ++i)
+        thermometer.set_temperature(start + i * 1us, i);
+
+    REQUIRE(throttled.values == std::vector<double>{0});
+    REQUIRE(immediate.values.size() == 1000);
+    REQUIRE(thermometer.has_pending());
+
+    SECTION("poll before the window elapses delivers nothing")
+    {
+        thermometer.poll(start + 5ms);
+        REQUIRE(throttled.values.size() == 1);
+    }
+
+    SECTION("poll after the window delivers only the newest event")
+    {
+        thermometer.poll(start + 10ms);
+        REQUIRE(throttled.values == std::vector<double>{0, 999});
+        REQUIRE(throttled.last_text == std::to_string(999.0));
+        REQUIRE_FALSE(thermometer.has_pending());
+
+        thermometer.poll(start + 50ms);
+        REQUIRE(throttled.values.size() == 2);
+    }
+
+    SECTION("next event after the window is delivered immediately")
+    {
+        thermometer.set_temperature(start + 20ms, 2000);
+        REQUIRE(throttled.values == std::vector<double>{0, 2000});
+    }
+
+    SECTION("flush ignores the window")
+    {
+        thermometer.flush();
+        REQUIRE(throttled.values == std::vector<double>{0, 999});
+    }
+}
+
+TEST_CASE("ThrottledObservable bounds the number of updates by the interval", "[observer][throttled]")
+{
+    Thermometer thermometer;
+    RecordingObserver observer;
+    thermometer.subscribe(&observer, 1ms);
+
+    const auto start = Clock::now();
+    for (int i = 0; i < 100'000; ++i) // 100 ms of updates every microsecond
+        thermometer.set_temperature(start + i * 1us, i);
+
+    REQUIRE(observer.values.size() == 100);
+}
+
+TEST_CASE("ThrottledObservable unsubscribe", "[observer][throttled]")
+{
+    Thermometer thermometer;
+    RecordingObserver observer;
+    thermometer.subscribe(&observer, 1ms);
+
+    const auto start = Clock::now();
+    thermometer.set_temperature(start, 1);
+    thermometer.set_temperature(start, 2);
+    thermometer.unsubscribe(&observer);
+    thermometer.flush();
+
+    REQUIRE(observer.values == std::vector<double>{1});
+}
@@ -0,0 +1,117 @@
+#ifndef THROTTLED_OBSERVER_HPP_
+#define THROTTLED_OBSERVER_HPP_
+
+#include "observer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Observable for high-frequency sources. Every subscription has a minimal interval between
+// updates: an event arriving inside the window is not delivered, the observer is only marked
+// as pending. Pending events are coalesced - when the window elapses (on the next notify() or
+// poll()) the observer gets just the newest event. Observer work is bounded by the interval,
+// not by the update rate, and the newest event is stored once for all observers.
+//
+// Subscribing and unsubscribing from inside update() is not supported.
+template <typename TSource, typename... TEventArgs>
+class ThrottledObservable
+{
+public:
+    using ObserverType = Observer<TSource, TEventArgs...>;
+    using Clock = std::chrono::steady_clock;
+
+    // min_interval == 0 - every event is delivered immediately
+    void subscribe(ObserverType* observer, Clock::duration min_interval = Clock::duration::zero())
+    {
+        subscriptions_.push_back(Subscription{observer, min_interval, Clock::time_point::min(), false});
+    }
+
+    void unsubscribe(ObserverType* observer)
+    {
+        auto it = std::find_if(subscriptions_.begin(), subscriptions_.end(), [observer](const Subscription& s) { return s.observer == observer; });
+        if (it != subscriptions_.end())
+            subscriptions_.erase(it);
+    }
+
+    // Delivers the newest event to pending observers whose window has elapsed
+    void poll()
+    {
+        poll(Clock::now());
+    }
+
+    void poll(Clock::time_point now)
+    {
+        for (Subscription& subscription : subscriptions_)
+        {
+            if (subscription.pending && now >= subscription.next_delivery)
+                deliver(subscription, now);
+        }
+    }
+
+    // Delivers the newest event to all pending observers, ignoring their windows
+    void flush()
+    {
+        const auto now = Clock::now();
+        for (Subscription& subscription : subscriptions_)
+        {
+            if (subscription.pending)
+                deliver(subscription, now);
+        }
+    }
+
+    bool has_pending() const
+    {
+        return std::any_of(subscriptions_.begin(), subscriptions_.end(), [](const Subscription& s) { return s.pending; });
+    }
+
+protected:
+    void notify(TSource& source, EventParam<TEventArgs>... args)
+    {
+        notify_at(Clock::now(), source, args...);
+    }
+
+    void notify_at(Clock::time_point now, TSource& source, EventParam<TEventArgs>... args)
+    {
+        source_ = &source;
+        if (latest_)
+            *latest_ = std::forward_as_tuple(args...); // reuses storage of the previous event
+        else
+            latest_.emplace(args...);
+
+        for (Subscription& subscription : subscriptions_)
+        {
+            if (now >= subscription.next_delivery)
+                deliver(subscription, now);
+            else
+                subscription.pending = true;
+        }
+    }
+
+private:
+    struct Subscription
+    {
+        ObserverType* observer;
+        Clock::duration min_interval;
+        Clock::time_point next_delivery;
+        bool pending;
+    };
+
+    std::vector<Subscription> subscriptions_;
+    TSource* source_ = nullptr;
+    std::optional<std::tuple<std::decay_t<TEventArgs>...>> latest_;
+
+    void deliver(Subscription& subscription, Clock::time_point now)
+    {
+        subscription.pending = false;
+        subscription.next_delivery = now + subscription.min_interval;
+
+        std::apply([this, &subscription](const auto&... args) { subscription.observer->update(*source_, args...); }, *latest_);
+    }
+};
+
+#endif /*THROTTLED_OBSERVER_HPP_*/
@@ -0,0 +1,159 @@
+#include "data_loader.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace
+{
+    constexpr std::size_t value_count = 8 * 1024 * 1024;
+
+    // Data files written once - text with values as in the .dat files, and the same values as .f64
+    class DataFiles
+    {
+        std::string text_;
+        std::string binary_;
+
+    public:
+        DataFiles()
+            : text_{(std::filesystem::temp_directory_path() / "data_loader_benchmark.dat").string()}
+            , binary_{(std::filesystem::temp_directory_path() / "data_loader_benchmark.f64").string()}
+        {
+            std::mt19937_64 generator{42};
+            std::uniform_real_distribution<double> value{0.0, 100.0};
+
+            Data data(value_count);
+            for (auto& item : data)
+                item = value(generator);
+
+            std::ofstream out{text_};
+            out.precision(17);
+            for (double item : data)
+                out << item << '\n';
+
+            DataLoader::save_f64(binary_, data);
+        }
+
+        DataFiles(const DataFiles&) = delete;
+        DataFiles& operator=(const DataFiles&) = delete;
+
+        ~DataFiles()
+        {
+            std::remove(text_.c_str());
+            std::remove(binary_.c_str());
+        }
+
+        const std::string& text() const
+        {
+            return text_;
+        }
+
+        const std::string& binary() const
+        {
+            return binary_;
+        }
+    };
+
+    const DataFiles& files()
+    {
+        static const DataFiles files;
+        return files;
+    }
+
+    void report(benchmark::State& state, const std::string& file_name)
+    {
+        state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(file_name));
+        state.counters["values"] = value_count;
+    }
+} // namespace
+
+// Previous DataAnalyzer::load_data - kept as a baseline
+static void BM_LoadText_Stream(benchmark::State& state)
+{
+    const auto& file_name = files().text();
+
+    for (auto _ : state)
+    {
+        Data data;
+        std::ifstream fin(file_name.c_str());
+        double d;
+        while (fin >> d)
+            data.push_back(d);
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    report(state, file_name);
+}
+BENCHMARK(BM_LoadText_Stream)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// state.range(0) threads
+static void BM_LoadText_FromChars(benchmark::State& state)
+{
+    const auto& file_name = files().text();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(DataLoader::load_text(file_name, state.range(0)).data());
+
+    report(state, file_name);
+}
+BENCHMARK(BM_LoadText_FromChars)->Arg(1)->Arg(2)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_LoadF64(benchmark::State& state)
+{
+    const auto& file_name = files().binary();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(DataLoader::load_f64(file_name).data());
+
+    report(state, file_name);
+}
+BENCHMARK(BM_LoadF64)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+namespace
+{
+    using StreamedStatistics = FusedStatistics<Accumulators::Avg, Accumulators::Min, Accumulators::Max, Accumulators::Sum,
+        Accumulators::Variance, Accumulators::Percentile<50>>;
+}
+
+// Whole file loaded, then the statistics calculated - memory grows with the file
+static void BM_LoadAndCalculate(benchmark::State& state)
+{
+    const auto& file_name = state.range(0) ? files().binary() : files().text();
+
+    for (auto _ : state)
+    {
+        Results results;
+        StreamedStatistics{}(DataLoader::load(file_name), results);
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    report(state, file_name);
+}
+BENCHMARK(BM_LoadAndCalculate)->ArgName("f64")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// The statistics of the file streamed through a buffer of state.range(1) bytes - memory is constant
+static void BM_StreamAndCalculate(benchmark::State& state)
+{
+    const auto& file_name = state.range(0) ? files().binary() : files().text();
+
+    for (auto _ : state)
+    {
+        Results results;
+        DataLoader::ChunkReader reader{file_name, static_cast<std::size_t>(state.range(1))};
+        StreamedStatistics{}([&reader](Data& chunk) { return reader.read(chunk); }, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    report(state, file_name);
+    state.counters["buffer_bytes"] = static_cast<double>(state.range(1));
+}
+BENCHMARK(BM_StreamAndCalculate)
+    ->ArgNames({"f64", "buffer"})
+    ->ArgsProduct({{0, 1}, {64 * 1024, 1024 * 1024}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,91 @@
+#include "statistics.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Data& data(std::size_t size)
+    {
+        static Data data;
+        if (data.size() != size)
+        {
+            data.clear();
+            data.shrink_to_fit();
+            data.resize(size);
+
+            std::mt19937_64 generator{42};
+            std::uniform_real_distribution<double> value{0.0, 100.0};
+            for (auto& item : data)
+                item = value(generator);
+        }
+        return data;
+    }
+
+    // Strategies of main.cpp - every statistic scans the data on its own
+    using Statistics = std::function<void(const Data&, Results&)>;
+
+    const std::vector<Statistics> separate_statistics = {
+        [](const Data& data, Results& results) {
+            results.push_back(StatResult("Avg", std::accumulate(data.begin(), data.end(), 0.0) / data.size()));
+        },
+        [](const Data& data, Results& results) {
+            results.push_back(StatResult("Min", *std::min_element(data.begin(), data.end())));
+        },
+        [](const Data& data, Results& results) {
+            results.push_back(StatResult("Max", *std::max_element(data.begin(), data.end())));
+        },
+        [](const Data& data, Results& results) {
+            results.push_back(StatResult("Sum", std::accumulate(data.begin(), data.end(), 0.0)));
+        },
+    };
+
+    void report(benchmark::State& state, std::size_t passes)
+    {
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+        state.counters["passes"] = static_cast<double>(passes);
+    }
+} // namespace
+
+static void BM_SeparatePasses(benchmark::State& state)
+{
+    const Data& values = data(state.range(0));
+
+    for (auto _ : state)
+    {
+        Results results;
+        for (const auto& statistics : separate_statistics)
+            statistics(values, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    report(state, separate_statistics.size());
+}
+BENCHMARK(BM_SeparatePasses)->RangeMultiplier(8)->Range(1 << 15, 1 << 27)->Unit(benchmark::kMillisecond);
+
+// state.range(1) threads - wall time
+static void BM_FusedStatistics(benchmark::State& state)
+{
+    const Data& values = data(state.range(0));
+    const FusedStatistics<Accumulators::Avg, Accumulators::Min, Accumulators::Max, Accumulators::Sum> statistics{
+        static_cast<std::size_t>(state.range(1))};
+
+    for (auto _ : state)
+    {
+        Results results;
+        statistics(values, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    report(state, 1);
+}
+BENCHMARK(BM_FusedStatistics)
+    ->ArgsProduct({benchmark::CreateRange(1 << 15, 1 << 27, 8), {1, 2, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
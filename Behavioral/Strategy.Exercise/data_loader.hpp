@@ -0,0 +1,362 @@
+#ifndef DATA_LOADER_HPP_
+#define DATA_LOADER_HPP_
+
+#include "statistics.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Read-only memory mapped file - the data is paged in by the OS as it is read, with no copy
+// to a buffer of ours
+class MappedFile
+{
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& file_name)
+    {
+#ifdef _WIN32
+        file_ = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("File not opened");
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size))
+        {
+            close();
+            throw std::runtime_error("File not opened");
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+
+        if (size_ == 0) // empty file can't be mapped
+            return;
+
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view)
+        {
+            close();
+            throw std::runtime_error("File not mapped");
+        }
+        data_ = static_cast<const char*>(view);
+#else
+        const int fd = ::open(file_name.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("File not opened");
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("File not opened");
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+
+        if (size_ != 0) // empty file can't be mapped
+        {
+            void* view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("File not mapped");
+            }
+            ::madvise(view, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(view);
+        }
+
+        ::close(fd); // the mapping stays valid
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    const char* data() const
+    {
+        return data_;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+private:
+    void close()
+    {
+#ifdef _WIN32
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mapping_)
+            CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+        data_ = nullptr;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Loading of data files:
+//  - text - numbers separated by whitespace, parsed with std::from_chars (no locale, no stream)
+//    from a memory mapped file, large files by several threads
+//  - binary .f64 - raw doubles in the byte order of the machine, loaded by a single copy
+namespace DataLoader
+{
+    // Text files smaller than this per thread are parsed by fewer threads
+    constexpr std::size_t min_chunk_size = 1024 * 1024;
+
+    inline bool is_space(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+    }
+
+    // Appends the whitespace separated numbers of [first, last) to data
+    inline void parse_text(const char* first, const char* last, Data& data)
+    {
+        while (true)
+        {
+            while (first != last && is_space(*first))
+                ++first;
+            if (first == last)
+                return;
+
+            if (*first == '+' && last - first > 1 && first[1] != '-') // accepted by operator>>, not by from_chars
+                ++first;
+
+            double value;
+            const auto [end, error] = std::from_chars(first, last, value);
+            if (error != std::errc{} || (end != last && !is_space(*end)))
+                throw std::runtime_error("Invalid number: " + std::string(first, std::find_if(first, last, is_space)));
+
+            data.push_back(value);
+            first = end;
+        }
+    }
+
+    inline Data load_text(const std::string& file_name, std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        const MappedFile file{file_name};
+        const char* const first = file.data();
+        const char* const last = first + file.size();
+
+        // chunks split at whitespace - no number is cut in two
+        const std::size_t chunk_count = std::clamp<std::size_t>(file.size() / min_chunk_size, 1, std::max<std::size_t>(1, thread_count));
+        std::vector<const char*> bounds{first};
+        for (std::size_t i = 1; i < chunk_count; ++i)
+            bounds.push_back(std::find_if(std::max(bounds.back(), first + file.size() * i / chunk_count), last, is_space));
+        bounds.push_back(last);
+
+        std::vector<Data> chunks(chunk_count);
+        std::vector<std::exception_ptr> errors(chunk_count);
+        std::vector<std::thread> threads;
+        threads.reserve(chunk_count - 1);
+        for (std::size_t i = 1; i < chunk_count; ++i)
+        {
+            threads.emplace_back([&, i] {
+                try
+                {
+                    parse_text(bounds[i], bounds[i + 1], chunks[i]);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+
+        try
+        {
+            parse_text(bounds[0], bounds[1], chunks[0]);
+        }
+        catch (...)
+        {
+            errors[0] = std::current_exception();
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        for (const auto& error : errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        if (chunk_count == 1)
+            return std::move(chunks[0]);
+
+        std::size_t size = 0;
+        for (const auto& chunk : chunks)
+            size += chunk.size();
+
+        Data data;
+        data.reserve(size);
+        for (const auto& chunk : chunks)
+            data.insert(data.end(), chunk.begin(), chunk.end());
+        return data;
+    }
+
+    inline Data load_f64(const std::string& file_name)
+    {
+        const MappedFile file{file_name};
+        if (file.size() % sizeof(double) != 0)
+            throw std::runtime_error("Size of " + file_name + " is not a multiple of " + std::to_string(sizeof(double)));
+
+        Data data(file.size() / sizeof(double));
+        if (!data.empty())
+            std::memcpy(data.data(), file.data(), file.size());
+        return data;
+    }
+
+    inline void save_f64(const std::string& file_name, const Data& data)
+    {
+        std::FILE* file = std::fopen(file_name.c_str(), "wb");
+        if (!file)
+            throw std::runtime_error("File not opened");
+
+        const std::size_t written = data.empty() ? 0 : std::fwrite(data.data(), sizeof(double), data.size(), file);
+        if (std::fclose(file) != 0 || written != data.size())
+            throw std::runtime_error("File " + file_name + " not written");
+    }
+
+    inline bool is_f64(const std::string& file_name)
+    {
+        const std::string extension = ".f64";
+        return file_name.size() >= extension.size() && file_name.compare(file_name.size() - extension.size(), extension.size(), extension) == 0;
+    }
+
+    // Format chosen by the extension of the file
+    inline Data load(const std::string& file_name)
+    {
+        return is_f64(file_name) ? load_f64(file_name) : load_text(file_name);
+    }
+
+    // Reads a data file (format chosen by the extension) chunk by chunk through a buffer of
+    // buffer_size bytes - memory used does not depend on the size of the file
+    class ChunkReader
+    {
+        std::FILE* file_;
+        bool binary_;
+        std::vector<char> buffer_;
+        std::size_t pending_ = 0; // bytes of a number cut by the end of the previous read
+        bool eof_ = false;
+
+    public:
+        static constexpr std::size_t default_buffer_size = 1024 * 1024;
+
+        explicit ChunkReader(const std::string& file_name, std::size_t buffer_size = default_buffer_size)
+            : file_{std::fopen(file_name.c_str(), "rb")}
+            , binary_{is_f64(file_name)}
+            , buffer_(std::max(buffer_size, sizeof(double)) / sizeof(double) * sizeof(double))
+        {
+            if (!file_)
+                throw std::runtime_error("File not opened");
+        }
+
+        ChunkReader(const ChunkReader&) = delete;
+        ChunkReader& operator=(const ChunkReader&) = delete;
+
+        ~ChunkReader()
+        {
+            std::fclose(file_);
+        }
+
+        // Replaces the content of chunk with the following values - false at the end of the file
+        bool read(Data& chunk)
+        {
+            chunk.clear();
+
+            while (chunk.empty()) // a buffer of whitespace only has no values
+            {
+                if (eof_)
+                    return false;
+
+                const std::size_t size = pending_ + fill(buffer_.data() + pending_, buffer_.size() - pending_);
+                const char* const first = buffer_.data();
+                const char* const last = first + size;
+
+                if (binary_)
+                {
+                    if (size % sizeof(double) != 0)
+                        throw std::runtime_error("Size of the file is not a multiple of " + std::to_string(sizeof(double)));
+
+                    chunk.resize(size / sizeof(double));
+                    if (!chunk.empty())
+                        std::memcpy(chunk.data(), first, size);
+                    continue;
+                }
+
+                // the number at the end of the buffer may continue in the next read
+                const char* end = last;
+                if (!eof_)
+                {
+                    end = std::find_if(std::make_reverse_iterator(last), std::make_reverse_iterator(first), is_space).base();
+                    if (end == first)
+                        throw std::runtime_error("Number longer than the buffer: " + std::string(first, std::min<std::size_t>(size, 32)));
+                }
+
+                parse_text(first, end, chunk);
+
+                pending_ = static_cast<std::size_t>(last - end);
+                std::memmove(buffer_.data(), end, pending_);
+            }
+
+            return true;
+        }
+
+    private:
+        std::size_t fill(char* buffer, std::size_t size)
+        {
+            const std::size_t count = std::fread(buffer, 1, size, file_);
+            if (count < size)
+            {
+                if (std::ferror(file_))
+                    throw std::runtime_error("File not read");
+                eof_ = true;
+            }
+            return count;
+        }
+    };
+} // namespace DataLoader
+
+#endif /*DATA_LOADER_HPP_*/
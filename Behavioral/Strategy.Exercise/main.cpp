@@ -1,29 +1,17 @@
+#include "data_loader.hpp"
+#include "statistics.hpp"
+
 #include <algorithm>
-#include <fstream>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <list>
+#include <memory>
 #include <numeric>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
-struct StatResult
-{
-    std::string description;
-    double value;
-
-    StatResult(const std::string& desc, double val)
-        : description(desc)
-        , value(val)
-    {
-    }
-};
-
-using Data = std::vector<double>;
-using Results = std::vector<StatResult>;
-
 namespace Canonical
 {
     class Statistics
@@ -143,6 +131,7 @@ public:
 class DataAnalyzer
 {
     Statistics strategy_;
+    StreamingStatistics streaming_strategy_;
     Data data_;
     Results results_;
 
@@ -157,15 +146,7 @@ public:
         data_.clear();
         results_.clear();
 
-        std::ifstream fin(file_name.c_str());
-        if (!fin)
-            throw std::runtime_error("File not opened");
-
-        double d;
-        while (fin >> d)
-        {
-            data_.push_back(d);
-        }
+        data_ = DataLoader::load(file_name);
 
         std::cout << "File " << file_name << " has been loaded...\n";
     }
@@ -180,6 +161,26 @@ public:
         strategy_(data_, results_);
     }
 
+    void set_streaming_strategy(StreamingStatistics strategy)
+    {
+        streaming_strategy_ = strategy;
+    }
+
+    // Streaming mode for files larger than memory - the file is read in chunks passed through
+    // the streaming strategy and is not loaded as data
+    void calculate_streaming(const std::string& file_name, std::size_t buffer_size = DataLoader::ChunkReader::default_buffer_size)
+    {
+        if (!streaming_strategy_)
+            throw std::logic_error("Streaming strategy not set");
+
+        results_.clear();
+
+        DataLoader::ChunkReader reader{file_name, buffer_size};
+        streaming_strategy_([&reader](Data& chunk) { return reader.read(chunk); }, results_);
+
+        std::cout << "File " << file_name << " has been streamed...\n";
+    }
+
     const Results& results() const
     {
         return results_;
@@ -222,4 +223,22 @@ int main()
     da.calculate();
 
     show_results(da.results());
+
+    std::cout << "\n\n";
+
+    // the same statistics in a single pass over the data
+    da.set_strategy(FusedStatistics<Accumulators::Avg, Accumulators::Min, Accumulators::Max, Accumulators::Sum>{});
+    da.load_data("stats_data.dat");
+    da.calculate();
+
+    show_results(da.results());
+
+    std::cout << "\n\n";
+
+    // the file read in chunks of 64 bytes - as if it did not fit in memory
+    da.set_streaming_strategy(FusedStatistics<Accumulators::Avg, Accumulators::Min, Accumulators::Max, Accumulators::Variance,
+        Accumulators::Percentile<50>, Accumulators::Percentile<90>>{});
+    da.calculate_streaming("stats_data.dat", 64);
+
+    show_results(da.results());
 }
@@ -0,0 +1,400 @@
+#ifndef STATISTICS_HPP_
+#define STATISTICS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct StatResult
+{
+    std::string description;
+    double value;
+
+    StatResult(const std::string& desc, double val)
+        : description(desc)
+        , value(val)
+    {
+    }
+};
+
+using Data = std::vector<double>;
+using Results = std::vector<StatResult>;
+
+// Data read chunk by chunk - replaces the content of chunk with the following values, false at
+// the end of data
+using DataSource = std::function<bool(Data& chunk)>;
+
+// Strategy for data not held in memory as a whole - reads all chunks of the source
+using StreamingStatistics = std::function<void(const DataSource& source, Results& results)>;
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Accumulators - statistics computed value by value in constant memory. A statistic of a part of
+// the data can be merged with the one of the following part (except for Percentile), so the data
+// can be split between threads.
+namespace Accumulators
+{
+    class Sum
+    {
+        double sum_ = 0.0;
+
+    public:
+        void add(double value)
+        {
+            sum_ += value;
+        }
+
+        void merge(const Sum& other)
+        {
+            sum_ += other.sum_;
+        }
+
+        void report(Results& results) const
+        {
+            results.push_back(StatResult("Sum", sum_));
+        }
+    };
+
+    class Avg
+    {
+        double sum_ = 0.0;
+        std::size_t count_ = 0;
+
+    public:
+        void add(double value)
+        {
+            sum_ += value;
+            ++count_;
+        }
+
+        void merge(const Avg& other)
+        {
+            sum_ += other.sum_;
+            count_ += other.count_;
+        }
+
+        // NaN for no data
+        void report(Results& results) const
+        {
+            results.push_back(StatResult("Avg", sum_ / count_));
+        }
+    };
+
+    class Min
+    {
+        double min_ = std::numeric_limits<double>::infinity();
+        std::size_t count_ = 0;
+
+    public:
+        void add(double value)
+        {
+            min_ = value < min_ ? value : min_;
+            ++count_;
+        }
+
+        void merge(const Min& other)
+        {
+            min_ = std::min(min_, other.min_);
+            count_ += other.count_;
+        }
+
+        // NaN for no data
+        void report(Results& results) const
+        {
+            results.push_back(StatResult("Min", count_ ? min_ : std::numeric_limits<double>::quiet_NaN()));
+        }
+    };
+
+    class Max
+    {
+        double max_ = -std::numeric_limits<double>::infinity();
+        std::size_t count_ = 0;
+
+    public:
+        void add(double value)
+        {
+            max_ = value > max_ ? value : max_;
+            ++count_;
+        }
+
+        void merge(const Max& other)
+        {
+            max_ = std::max(max_, other.max_);
+            count_ += other.count_;
+        }
+
+        // NaN for no data
+        void report(Results& results) const
+        {
+            results.push_back(StatResult("Max", count_ ? max_ : std::numeric_limits<double>::quiet_NaN()));
+        }
+    };
+
+    // Sample variance - Welford's update, merged as by Chan et al.
+    class Variance
+    {
+        std::size_t count_ = 0;
+        double mean_ = 0.0;
+        double m2_ = 0.0; // sum of squared differences from the mean
+
+    public:
+        void add(double value)
+        {
+            ++count_;
+            const double delta = value - mean_;
+            mean_ += delta / count_;
+            m2_ += delta * (value - mean_);
+        }
+
+        void merge(const Variance& other)
+        {
+            if (other.count_ == 0)
+                return;
+
+            const double count = static_cast<double>(count_ + other.count_);
+            const double delta = other.mean_ - mean_;
+            mean_ += delta * other.count_ / count;
+            m2_ += other.m2_ + delta * delta * count_ / count * other.count_;
+            count_ += other.count_;
+        }
+
+        // NaN for less than two values
+        void report(Results& results) const
+        {
+            results.push_back(StatResult("Variance", count_ > 1 ? m2_ / (count_ - 1) : std::numeric_limits<double>::quiet_NaN()));
+        }
+    };
+
+    // Approximate Percent-th percentile - the P-square algorithm (R. Jain, I. Chlamtac, 1985)
+    // keeps five markers whose heights follow the minimum, the p/2, p and (1+p)/2 quantiles and
+    // the maximum. Exact for up to five values. Can't be merged.
+    template <int Percent>
+    class Percentile
+    {
+        static_assert(0 < Percent && Percent < 100, "Percentile must be in (0, 100)");
+
+        static constexpr double p_ = Percent / 100.0;
+        static constexpr double increments_[5] = {0.0, p_ / 2, p_, (1 + p_) / 2, 1.0};
+
+        std::size_t count_ = 0;
+        double heights_[5] = {};
+        double positions_[5] = {1, 2, 3, 4, 5};
+        double desired_[5] = {1, 1 + 2 * p_, 1 + 4 * p_, 3 + 2 * p_, 5};
+
+    public:
+        void add(double value)
+        {
+            if (count_ < 5)
+            {
+                heights_[count_++] = value;
+                std::sort(heights_, heights_ + count_);
+                return;
+            }
+            ++count_;
+
+            // markers above the value move right - branchless, the order of values is random
+            heights_[0] = std::min(heights_[0], value);
+            heights_[4] = std::max(heights_[4], value);
+            for (int i = 1; i < 4; ++i)
+                positions_[i] += value < heights_[i];
+            positions_[4] += 1;
+            for (int i = 0; i < 5; ++i)
+                desired_[i] += increments_[i];
+
+            for (int i = 1; i < 4; ++i)
+            {
+                const double offset = desired_[i] - positions_[i];
+                if ((offset >= 1 && positions_[i + 1] - positions_[i] > 1) || (offset <= -1 && positions_[i - 1] - positions_[i] < -1))
+                {
+                    const int step = offset > 0 ? 1 : -1;
+                    const double height = parabolic(i, step);
+                    heights_[i] = heights_[i - 1] < height && height < heights_[i + 1] ? height : linear(i, step);
+                    positions_[i] += step;
+                }
+            }
+        }
+
+        // NaN for no data
+        void report(Results& results) const
+        {
+            results.push_back(StatResult("P" + std::to_string(Percent), value()));
+        }
+
+        double value() const
+        {
+            if (count_ == 0)
+                return std::numeric_limits<double>::quiet_NaN();
+            if (count_ <= 5) // nearest rank
+                return heights_[static_cast<std::size_t>(std::ceil(p_ * count_)) - 1];
+            return heights_[2];
+        }
+
+    private:
+        double parabolic(int i, int step) const
+        {
+            const double* q = heights_;
+            const double* n = positions_;
+            return q[i] + step / (n[i + 1] - n[i - 1])
+                * ((n[i] - n[i - 1] + step) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) + (n[i + 1] - n[i] - step) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+        }
+
+        double linear(int i, int step) const
+        {
+            return heights_[i] + step * (heights_[i + step] - heights_[i]) / (positions_[i + step] - positions_[i]);
+        }
+    };
+
+    template <typename TAccumulator, typename = void>
+    struct IsMergeable : std::false_type
+    {
+    };
+
+    template <typename TAccumulator>
+    struct IsMergeable<TAccumulator, std::void_t<decltype(std::declval<TAccumulator&>().merge(std::declval<const TAccumulator&>()))>>
+        : std::true_type
+    {
+    };
+
+    template <typename TAccumulator>
+    constexpr bool is_mergeable_v = IsMergeable<TAccumulator>::value;
+} // namespace Accumulators
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Strategy computing several statistics in a single pass over the data - every value is read
+// once and fed to all accumulators, while a StatisticsGroup scans the data once per statistic.
+// Large data is split into consecutive chunks accumulated by separate threads; the partial
+// results are merged in the order of the chunks, so results depend only on the thread count.
+// With an accumulator that can't be merged (Percentile) the data is accumulated by one thread.
+//
+// Streaming: a DataSource is accumulated chunk by chunk - memory used does not depend on the size
+// of the data.
+//
+// Results are reported in the order of the accumulators:
+//     DataAnalyzer da{FusedStatistics<Accumulators::Avg, Accumulators::Min, Accumulators::Max>{}};
+template <typename... TAccumulators>
+class FusedStatistics
+{
+public:
+    static constexpr bool is_mergeable = (Accumulators::is_mergeable_v<TAccumulators> && ...);
+
+    // Statistics of a part of the data
+    class Partial
+    {
+        std::tuple<TAccumulators...> accumulators_;
+
+    public:
+        void add(const double* first, const double* last)
+        {
+            auto accumulators = accumulators_; // locals - kept in registers
+            for (; first != last; ++first)
+                std::apply([value = *first](auto&... accumulator) { (accumulator.add(value), ...); }, accumulators);
+            accumulators_ = accumulators;
+        }
+
+        void add(const Data& data)
+        {
+            add(data.data(), data.data() + data.size());
+        }
+
+        // other is the part following this one
+        template <bool Mergeable = is_mergeable, typename = std::enable_if_t<Mergeable>>
+        void merge(const Partial& other)
+        {
+            merge(other, std::index_sequence_for<TAccumulators...>{});
+        }
+
+        void report(Results& results) const
+        {
+            std::apply([&results](const auto&... accumulator) { (accumulator.report(results), ...); }, accumulators_);
+        }
+
+    private:
+        template <std::size_t... Indexes>
+        void merge(const Partial& other, std::index_sequence<Indexes...>)
+        {
+            (std::get<Indexes>(accumulators_).merge(std::get<Indexes>(other.accumulators_)), ...);
+        }
+    };
+
+    // Smaller chunks are not worth a thread
+    static constexpr std::size_t min_chunk_size = 64 * 1024;
+
+private:
+    std::size_t thread_count_;
+
+public:
+    explicit FusedStatistics(std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+        : thread_count_{std::max<std::size_t>(1, thread_count)}
+    {
+    }
+
+    std::size_t thread_count() const
+    {
+        return thread_count_;
+    }
+
+    Partial accumulate(const double* first, const double* last) const
+    {
+        const auto size = static_cast<std::size_t>(last - first);
+        const std::size_t chunk_count = is_mergeable ? std::clamp<std::size_t>(size / min_chunk_size, 1, thread_count_) : 1;
+        const auto chunk = [=](std::size_t i) { return first + size * i / chunk_count; };
+
+        std::vector<Partial> partials(chunk_count);
+        std::vector<std::thread> threads;
+        threads.reserve(chunk_count - 1);
+        for (std::size_t i = 1; i < chunk_count; ++i)
+        {
+            threads.emplace_back([&partials, &chunk, i] {
+                Partial partial; // not in the shared vector while accumulating - no false sharing
+                partial.add(chunk(i), chunk(i + 1));
+                partials[i] = partial;
+            });
+        }
+
+        partials[0].add(chunk(0), chunk(1));
+
+        for (auto& thread : threads)
+            thread.join();
+
+        if constexpr (is_mergeable)
+        {
+            for (std::size_t i = 1; i < chunk_count; ++i)
+                partials[0].merge(partials[i]);
+        }
+
+        return partials[0];
+    }
+
+    Partial accumulate(const Data& data) const
+    {
+        return accumulate(data.data(), data.data() + data.size());
+    }
+
+    void operator()(const Data& data, Results& results) const
+    {
+        accumulate(data).report(results);
+    }
+
+    void operator()(const DataSource& source, Results& results) const
+    {
+        Partial total;
+        for (Data chunk; source(chunk);)
+        {
+            if constexpr (is_mergeable)
+                total.merge(accumulate(chunk));
+            else
+                total.add(chunk);
+        }
+
+        total.report(results);
+    }
+};
+
+#endif /*STATISTICS_HPP_*/
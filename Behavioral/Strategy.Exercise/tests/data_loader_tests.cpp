@@ -0,0 +1,189 @@
+#include "data_loader.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    // File removed at the end of the test
+    class TemporaryFile
+    {
+        std::string name_;
+
+    public:
+        explicit TemporaryFile(const std::string& name, const std::string& content = "")
+            : name_{(std::filesystem::temp_directory_path() / name).string()}
+        {
+            std::ofstream{name_, std::ios::binary} << content;
+        }
+
+        TemporaryFile(const TemporaryFile&) = delete;
+        TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+        ~TemporaryFile()
+        {
+            std::remove(name_.c_str());
+        }
+
+        const std::string& name() const
+        {
+            return name_;
+        }
+    };
+
+    Data stream_parse(const std::string& text)
+    {
+        Data data;
+        std::istringstream in{text};
+        double value;
+        while (in >> value)
+            data.push_back(value);
+        return data;
+    }
+} // namespace
+
+TEST_CASE("Text data is parsed as operator>> parses it", "[loader]")
+{
+    const std::string text = "47 26\n71\t-38.5\r\n+12 1e3 -2.5E-2 0.1 .5 5. 1234567890123456789\n";
+    const TemporaryFile file{"loader_text.dat", text};
+
+    CHECK(DataLoader::load_text(file.name()) == stream_parse(text));
+    CHECK(DataLoader::load(file.name()) == stream_parse(text));
+}
+
+TEST_CASE("Text data split between threads is loaded in order", "[loader]")
+{
+    std::mt19937_64 generator{42};
+    std::uniform_real_distribution<double> value{-1e6, 1e6};
+
+    std::string text;
+    while (text.size() < 3 * DataLoader::min_chunk_size + 100)
+        text += std::to_string(value(generator)) + (text.size() % 7 ? " " : "\n");
+    const TemporaryFile file{"loader_chunks.dat", text};
+
+    const Data expected = stream_parse(text);
+    for (std::size_t thread_count : {1, 2, 3, 4, 16})
+        CHECK(DataLoader::load_text(file.name(), thread_count) == expected);
+}
+
+TEST_CASE("Empty text data", "[loader]")
+{
+    const TemporaryFile empty{"loader_empty.dat"};
+    const TemporaryFile blank{"loader_blank.dat", " \n\n \t"};
+
+    CHECK(DataLoader::load_text(empty.name()).empty());
+    CHECK(DataLoader::load_text(blank.name()).empty());
+}
+
+TEST_CASE("Invalid text data throws", "[loader]")
+{
+    for (const std::string text : {"1 2 x 3", "1 2x 3", "1 - 3", "1 +-2", "1e999"})
+    {
+        const TemporaryFile file{"loader_invalid.dat", text};
+        CHECK_THROWS_AS(DataLoader::load_text(file.name()), std::runtime_error);
+    }
+}
+
+TEST_CASE("Missing file throws", "[loader]")
+{
+    CHECK_THROWS_AS(DataLoader::load("no_such_file.dat"), std::runtime_error);
+    CHECK_THROWS_AS(DataLoader::load("no_such_file.f64"), std::runtime_error);
+}
+
+TEST_CASE("Binary f64 data round trips", "[loader]")
+{
+    const TemporaryFile file{"loader_binary.f64"};
+    const Data data = {47.0, -0.1, 1e-300, std::numeric_limits<double>::infinity(), 0.0};
+
+    DataLoader::save_f64(file.name(), data);
+
+    CHECK(DataLoader::load_f64(file.name()) == data);
+    CHECK(DataLoader::load(file.name()) == data);
+
+    DataLoader::save_f64(file.name(), Data{});
+    CHECK(DataLoader::load(file.name()).empty());
+}
+
+TEST_CASE("Binary f64 data of a size not a multiple of a double throws", "[loader]")
+{
+    const TemporaryFile file{"loader_truncated.f64", "12345"};
+
+    CHECK_THROWS_AS(DataLoader::load(file.name()), std::runtime_error);
+}
+
+TEST_CASE("ChunkReader reads data in chunks equal to the whole", "[loader]")
+{
+    std::mt19937_64 generator{42};
+    std::uniform_real_distribution<double> value{-1e6, 1e6};
+
+    Data data(10'000);
+    std::string text;
+    for (auto& item : data)
+    {
+        item = std::round(value(generator) * 1000) / 1000;
+        text += std::to_string(item) + (text.size() % 5 ? " " : "  \n");
+    }
+
+    const TemporaryFile text_file{"reader_text.dat", text};
+    const TemporaryFile binary_file{"reader_binary.f64"};
+    DataLoader::save_f64(binary_file.name(), data);
+
+    for (const auto* file : {&text_file, &binary_file})
+    {
+        for (std::size_t buffer_size : {32, 100, 4096, 1 << 20})
+        {
+            DataLoader::ChunkReader reader{file->name(), buffer_size};
+
+            Data read, chunk;
+            std::size_t chunk_count = 0;
+            while (reader.read(chunk))
+            {
+                CHECK_FALSE(chunk.empty());
+                CHECK(chunk.size() * sizeof(double) <= 4 * std::max<std::size_t>(buffer_size, sizeof(double)));
+                read.insert(read.end(), chunk.begin(), chunk.end());
+                ++chunk_count;
+            }
+
+            CHECK(read == DataLoader::load(file->name()));
+            CHECK(chunk_count >= std::filesystem::file_size(file->name()) / buffer_size);
+            CHECK_FALSE(reader.read(chunk));
+        }
+    }
+}
+
+TEST_CASE("ChunkReader of empty data", "[loader]")
+{
+    const TemporaryFile empty{"reader_empty.dat"};
+    const TemporaryFile blank{"reader_blank.dat", std::string(1000, ' ')};
+
+    Data chunk = {1.0};
+    CHECK_FALSE(DataLoader::ChunkReader{empty.name()}.read(chunk));
+    CHECK(chunk.empty());
+    CHECK_FALSE(DataLoader::ChunkReader{blank.name(), 64}.read(chunk));
+}
+
+TEST_CASE("ChunkReader of invalid data throws", "[loader]")
+{
+    const TemporaryFile long_number{"reader_long.dat", "1 " + std::string(100, '1')};
+    const TemporaryFile truncated{"reader_truncated.f64", "12345"};
+
+    Data chunk;
+    DataLoader::ChunkReader long_reader{long_number.name(), 64};
+    CHECK(long_reader.read(chunk));
+    CHECK(chunk == Data{1.0});
+    CHECK_THROWS_AS(long_reader.read(chunk), std::runtime_error);
+
+    DataLoader::ChunkReader truncated_reader{truncated.name()};
+    CHECK_THROWS_AS(truncated_reader.read(chunk), std::runtime_error);
+
+    CHECK_THROWS_AS(DataLoader::ChunkReader{"no_such_file.dat"}, std::runtime_error);
+}
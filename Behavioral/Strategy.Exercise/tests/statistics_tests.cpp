@@ -0,0 +1,209 @@
+#include "statistics.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <random>
+
+namespace
+{
+    using StdStatistics = FusedStatistics<Accumulators::Avg, Accumulators::Min, Accumulators::Max, Accumulators::Sum>;
+
+    Data sample_data(std::size_t size)
+    {
+        std::mt19937_64 generator{42};
+        std::uniform_int_distribution<int> value{-1000, 1000};
+
+        Data data(size);
+        for (auto& item : data)
+            item = value(generator) / 4.0; // exact sums
+        return data;
+    }
+} // namespace
+
+TEST_CASE("FusedStatistics reports statistics in the order of accumulators", "[statistics]")
+{
+    const Data data = {47, 26, 71, 38, 1, 99};
+
+    Results results;
+    StdStatistics{}(data, results);
+
+    REQUIRE(results.size() == 4);
+    CHECK(results[0].description == "Avg");
+    CHECK(results[0].value == 47.0);
+    CHECK(results[1].description == "Min");
+    CHECK(results[1].value == 1.0);
+    CHECK(results[2].description == "Max");
+    CHECK(results[2].value == 99.0);
+    CHECK(results[3].description == "Sum");
+    CHECK(results[3].value == 282.0);
+}
+
+TEST_CASE("FusedStatistics of no data", "[statistics]")
+{
+    Results results;
+    StdStatistics{}(Data{}, results);
+
+    REQUIRE(results.size() == 4);
+    CHECK(std::isnan(results[0].value));
+    CHECK(std::isnan(results[1].value));
+    CHECK(std::isnan(results[2].value));
+    CHECK(results[3].value == 0.0);
+}
+
+TEST_CASE("FusedStatistics split between threads equal the separate passes", "[statistics]")
+{
+    const Data data = sample_data(3 * StdStatistics::min_chunk_size + 17);
+    const double sum = std::accumulate(data.begin(), data.end(), 0.0);
+
+    for (std::size_t thread_count : {1, 2, 3, 8})
+    {
+        Results results;
+        StdStatistics{thread_count}(data, results);
+
+        REQUIRE(results.size() == 4);
+        CHECK(results[0].value == sum / data.size());
+        CHECK(results[1].value == *std::min_element(data.begin(), data.end()));
+        CHECK(results[2].value == *std::max_element(data.begin(), data.end()));
+        CHECK(results[3].value == sum);
+    }
+}
+
+TEST_CASE("Partials of consecutive parts merge into statistics of the whole", "[statistics]")
+{
+    const Data data = sample_data(1000);
+
+    StdStatistics::Partial first, second, whole;
+    first.add(data.data(), data.data() + 300);
+    second.add(data.data() + 300, data.data() + data.size());
+    whole.add(data);
+    first.merge(second);
+
+    Results merged, expected;
+    first.report(merged);
+    whole.report(expected);
+
+    REQUIRE(merged.size() == expected.size());
+    for (std::size_t i = 0; i < merged.size(); ++i)
+    {
+        CHECK(merged[i].description == expected[i].description);
+        CHECK(merged[i].value == expected[i].value);
+    }
+}
+
+TEST_CASE("Variance is the sample variance - also of merged parts", "[statistics]")
+{
+    const Data data = sample_data(10'000);
+
+    double mean = std::accumulate(data.begin(), data.end(), 0.0) / data.size();
+    double squares = 0.0;
+    for (double value : data)
+        squares += (value - mean) * (value - mean);
+    const double expected = squares / (data.size() - 1);
+
+    for (std::size_t thread_count : {1, 3})
+    {
+        Results results;
+        FusedStatistics<Accumulators::Variance>{thread_count}.accumulate(data).report(results);
+
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].description == "Variance");
+        CHECK(std::abs(results[0].value - expected) < 1e-9 * expected);
+    }
+
+    Accumulators::Variance first, second;
+    first.add(1.0);
+    second.add(3.0);
+    second.add(5.0);
+    first.merge(second);
+    first.merge(Accumulators::Variance{});
+
+    Results results;
+    first.report(results);
+    CHECK(results[0].value == 4.0);
+}
+
+TEST_CASE("Percentile is approximated in constant memory", "[statistics]")
+{
+    std::mt19937_64 generator{7};
+    std::uniform_real_distribution<double> uniform{0.0, 1000.0};
+    std::normal_distribution<double> normal{50.0, 10.0};
+
+    Accumulators::Percentile<50> uniform_median;
+    Accumulators::Percentile<90> normal_p90;
+    Data uniform_values, normal_values;
+    for (int i = 0; i < 100'000; ++i)
+    {
+        uniform_values.push_back(uniform(generator));
+        uniform_median.add(uniform_values.back());
+        normal_values.push_back(normal(generator));
+        normal_p90.add(normal_values.back());
+    }
+
+    const auto exact = [](Data values, double fraction) {
+        const auto nth = values.begin() + static_cast<std::ptrdiff_t>(fraction * (values.size() - 1));
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    };
+
+    CHECK(std::abs(uniform_median.value() - exact(uniform_values, 0.5)) < 5.0);
+    CHECK(std::abs(normal_p90.value() - exact(normal_values, 0.9)) < 0.5);
+
+    Results results;
+    normal_p90.report(results);
+    CHECK(results[0].description == "P90");
+}
+
+TEST_CASE("Percentile of up to five values is exact", "[statistics]")
+{
+    Accumulators::Percentile<50> median;
+    CHECK(std::isnan(median.value()));
+
+    for (double value : {5.0, 1.0, 4.0})
+        median.add(value);
+    CHECK(median.value() == 4.0);
+
+    median.add(2.0);
+    median.add(3.0);
+    CHECK(median.value() == 3.0);
+}
+
+TEST_CASE("FusedStatistics with a percentile is accumulated by one thread", "[statistics]")
+{
+    using Statistics = FusedStatistics<Accumulators::Sum, Accumulators::Percentile<50>>;
+    STATIC_REQUIRE_FALSE(Statistics::is_mergeable);
+    STATIC_REQUIRE(StdStatistics::is_mergeable);
+
+    const Data data = sample_data(3 * Statistics::min_chunk_size);
+
+    Results single, split;
+    Statistics{1}(data, single);
+    Statistics{8}(data, split);
+
+    REQUIRE(single.size() == 2);
+    CHECK(split[0].value == single[0].value);
+    CHECK(split[1].value == single[1].value);
+}
+
+TEST_CASE("FusedStatistics streamed chunk by chunk equal the ones of whole data", "[statistics]")
+{
+    const Data data = sample_data(5 * StdStatistics::min_chunk_size + 3);
+
+    std::size_t position = 0;
+    const DataSource source = [&](Data& chunk) {
+        const std::size_t size = std::min<std::size_t>(1000 + position % 7, data.size() - position);
+        chunk.assign(data.begin() + position, data.begin() + position + size);
+        position += size;
+        return size != 0;
+    };
+
+    Results streamed, whole;
+    StdStatistics{}(source, streamed);
+    StdStatistics{}(data, whole);
+
+    REQUIRE(streamed.size() == whole.size());
+    for (std::size_t i = 0; i < whole.size(); ++i)
+        CHECK(streamed[i].value == whole[i].value);
+}
@@ -0,0 +1,130 @@
+#include "ast.hpp"
+#include "ast_variant.hpp"
+#include "incremental_evaluator.hpp"
+#include "visitors.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace
+{
+    // Every third level is a multiplication by one - keeps the value of deep trees in range of int
+    AST::ExpressionNodePtr make_virtual_tree(int depth)
+    {
+        using namespace AST::helpers;
+
+        if (depth == 0)
+            return integer(1);
+
+        if (depth % 3 == 0)
+            return multiply(make_virtual_tree(depth - 1), integer(1));
+
+        return add(make_virtual_tree(depth - 1), make_virtual_tree(depth - 1));
+    }
+
+    AST::Variant::NodeId make_variant_tree(AST::Variant::NodePool& pool, int depth)
+    {
+        if (depth == 0)
+            return pool.integer(1);
+
+        if (depth % 3 == 0)
+        {
+            auto left = make_variant_tree(pool, depth - 1);
+            return pool.multiply(left, pool.integer(1));
+        }
+
+        auto left = make_variant_tree(pool, depth - 1);
+        auto right = make_variant_tree(pool, depth - 1);
+        return pool.add(left, right);
+    }
+}
+
+static void BM_VirtualVisitor_Evaluate(benchmark::State& state)
+{
+    auto expr = make_virtual_tree(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        ExprEvalVisitor evaluator;
+        expr->accept(evaluator);
+        benchmark::DoNotOptimize(evaluator.result());
+    }
+}
+BENCHMARK(BM_VirtualVisitor_Evaluate)->DenseRange(6, 18, 6);
+
+template <typename TEvaluator>
+static void BM_EvaluationMode(benchmark::State& state)
+{
+    auto expr = make_virtual_tree(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        TEvaluator evaluator;
+        expr->accept(evaluator);
+        benchmark::DoNotOptimize(evaluator.result());
+    }
+}
+BENCHMARK_TEMPLATE(BM_EvaluationMode, ExprEvalVisitor)->Arg(18);
+BENCHMARK_TEMPLATE(BM_EvaluationMode, Int64EvalVisitor)->Arg(18);
+BENCHMARK_TEMPLATE(BM_EvaluationMode, CheckedEvalVisitor)->Arg(18);
+#ifdef __SIZEOF_INT128__
+BENCHMARK_TEMPLATE(BM_EvaluationMode, Int128EvalVisitor)->Arg(18);
+#endif
+
+static void BM_VariantVisitor_Evaluate(benchmark::State& state)
+{
+    AST::Variant::NodePool pool;
+    auto root = make_variant_tree(pool, static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(AST::Variant::evaluate(pool, root));
+    }
+}
+BENCHMARK(BM_VariantVisitor_Evaluate)->DenseRange(6, 18, 6);
+
+static void BM_IncrementalEvaluator_EditLeafAndEvaluate(benchmark::State& state)
+{
+    AST::Variant::NodePool pool;
+    auto root = make_variant_tree(pool, static_cast<int>(state.range(0)));
+    AST::Variant::IncrementalEvaluator evaluator{pool};
+
+    int value = 0;
+    for (auto _ : state)
+    {
+        evaluator.set_value(0, value++ % 2);
+        benchmark::DoNotOptimize(evaluator.value(root));
+    }
+}
+BENCHMARK(BM_IncrementalEvaluator_EditLeafAndEvaluate)->DenseRange(6, 18, 6);
+
+static void BM_VirtualVisitor_Print(benchmark::State& state)
+{
+    auto expr = make_virtual_tree(static_cast<int>(state.range(0)));
+    std::string buffer;
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+        PrintingVisitor printer{buffer};
+        expr->accept(printer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+BENCHMARK(BM_VirtualVisitor_Print)->DenseRange(6, 18, 6);
+
+static void BM_VariantVisitor_Print(benchmark::State& state)
+{
+    AST::Variant::NodePool pool;
+    auto root = make_variant_tree(pool, static_cast<int>(state.range(0)));
+    std::string buffer;
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+        AST::Variant::print(pool, root, buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+BENCHMARK(BM_VariantVisitor_Print)->DenseRange(6, 18, 6);
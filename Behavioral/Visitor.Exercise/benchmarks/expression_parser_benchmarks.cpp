@@ -0,0 +1,91 @@
+#include "expression_parser.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    // Synthetic input - one random expression with ~20 operators per line
+    std::string make_expressions(std::size_t total_bytes)
+    {
+        std::mt19937 rnd{42};
+        std::uniform_int_distribution<int> value{0, 9999};
+        std::uniform_int_distribution<int> choice{0, 5};
+
+        std::string text;
+        text.reserve(total_bytes + 256);
+
+        while (text.size() < total_bytes)
+        {
+            int open_parens = 0;
+            for (int i = 0; i < 20; ++i)
+            {
+                if (choice(rnd) == 0)
+                {
+                    text += '(';
+                    ++open_parens;
+                }
+
+                text += std::to_string(value(rnd));
+
+                if (open_parens > 0 && choice(rnd) == 0)
+                {
+                    text += ')';
+                    --open_parens;
+                }
+
+                text += choice(rnd) < 3 ? " + " : " * ";
+            }
+            text += std::to_string(value(rnd));
+            text.append(open_parens, ')');
+            text += '\n';
+        }
+
+        return text;
+    }
+}
+
+static void BM_ParseLines_IntoNodePool(benchmark::State& state)
+{
+    const std::string text = make_expressions(static_cast<std::size_t>(state.range(0)));
+
+    AST::Variant::NodePool pool;
+    AST::Parsing::PoolBuilder builder{pool};
+    AST::Parsing::ExpressionParser parser{builder};
+
+    for (auto _ : state)
+    {
+        std::istringstream in{text};
+        auto count = AST::Parsing::parse_lines(in, parser, [&pool](AST::Variant::NodeId root, std::size_t) {
+            benchmark::DoNotOptimize(root);
+            pool.clear();
+        });
+        benchmark::DoNotOptimize(count);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParseLines_IntoNodePool)->Arg(1 << 20)->Arg(16 << 20);
+
+static void BM_ParseLines_IntoTree(benchmark::State& state)
+{
+    const std::string text = make_expressions(static_cast<std::size_t>(state.range(0)));
+
+    AST::Parsing::TreeBuilder builder;
+    AST::Parsing::ExpressionParser parser{builder};
+
+    for (auto _ : state)
+    {
+        std::istringstream in{text};
+        auto count = AST::Parsing::parse_lines(in, parser, [](AST::ExpressionNodePtr root, std::size_t) {
+            benchmark::DoNotOptimize(root.get());
+        });
+        benchmark::DoNotOptimize(count);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParseLines_IntoTree)->Arg(1 << 20);
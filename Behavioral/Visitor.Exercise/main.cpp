@@ -14,10 +14,8 @@ int main()
     ExprEvalVisitor evaluator;
     expr->accept(evaluator);
 
-    // TODO - uncomment code
-    
-    // PrintingVisitor printer;
-    // expr->accept(printer);
+    PrintingVisitor printer;
+    expr->accept(printer);
 
-    // cout << printer.str() << " = " << evaluator.result() << std::endl;
+    cout << printer.str() << " = " << evaluator.result() << std::endl;
 }
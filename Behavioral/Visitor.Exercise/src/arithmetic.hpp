@@ -0,0 +1,69 @@
+#ifndef ARITHMETIC_HPP
+#define ARITHMETIC_HPP
+
+#include <limits>
+#include <type_traits>
+
+// Arithmetic policies for evaluators - each operation stores the result and returns true on overflow
+namespace Arithmetic
+{
+    // Plain operators of the value type - overflow is never reported, so checks compile away
+    struct Unchecked
+    {
+        template <typename T>
+        static constexpr bool add(T left, T right, T& result)
+        {
+            result = left + right;
+            return false;
+        }
+
+        template <typename T>
+        static constexpr bool multiply(T left, T right, T& result)
+        {
+            result = left * right;
+            return false;
+        }
+    };
+
+    struct Checked
+    {
+        template <typename T>
+        static bool add(T left, T right, T& result)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_add_overflow(left, right, &result);
+#else
+            static_assert(std::is_signed_v<T>);
+
+            if ((right > 0 && left > std::numeric_limits<T>::max() - right)
+                || (right < 0 && left < std::numeric_limits<T>::min() - right))
+                return true;
+
+            result = left + right;
+            return false;
+#endif
+        }
+
+        template <typename T>
+        static bool multiply(T left, T right, T& result)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_mul_overflow(left, right, &result);
+#else
+            static_assert(std::is_signed_v<T>);
+
+            constexpr T max = std::numeric_limits<T>::max();
+            constexpr T min = std::numeric_limits<T>::min();
+
+            if (left > 0 ? (right > 0 ? left > max / right : right < min / left)
+                         : (right > 0 ? left < min / right : (left != 0 && right < max / left)))
+                return true;
+
+            result = left * right;
+            return false;
+#endif
+        }
+    };
+}
+
+#endif // ARITHMETIC_HPP
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace AST
 {
@@ -29,8 +30,35 @@ namespace AST
     public:
         virtual void accept(AstVisitor& v) = 0;
         virtual ~ExpressionNode() = default;
+
+        // Moves the children of the node to nodes - lets a deep tree be destroyed without recursion
+        virtual void release_children(std::vector<ExpressionNodePtr>& /*nodes*/)
+        {
+        }
     };
 
+    namespace detail
+    {
+        // Destroys the subtrees with an explicit stack - degenerate trees may be millions of levels deep
+        inline void destroy_subtrees(ExpressionNodePtr& left, ExpressionNodePtr& right)
+        {
+            if (!left && !right) // children already released
+                return;
+
+            std::vector<ExpressionNodePtr> nodes;
+            nodes.push_back(std::move(left));
+            nodes.push_back(std::move(right));
+
+            while (!nodes.empty())
+            {
+                ExpressionNodePtr node = std::move(nodes.back());
+                nodes.pop_back();
+                if (node)
+                    node->release_children(nodes);
+            }
+        }
+    }
+
     // CRTP for accept implementation in derived classes
     template <typename ExpressionType>
     class VisitableExpression : public ExpressionNode
@@ -52,6 +80,17 @@ namespace AST
         {
         }
 
+        ~AddNode()
+        {
+            detail::destroy_subtrees(left_, right_);
+        }
+
+        void release_children(std::vector<ExpressionNodePtr>& nodes) override
+        {
+            nodes.push_back(std::move(left_));
+            nodes.push_back(std::move(right_));
+        }
+
         ExpressionNode& left()
         {
             return *left_;
@@ -73,6 +112,17 @@ namespace AST
         {
         }
 
+        ~MultiplyNode()
+        {
+            detail::destroy_subtrees(left_, right_);
+        }
+
+        void release_children(std::vector<ExpressionNodePtr>& nodes) override
+        {
+            nodes.push_back(std::move(left_));
+            nodes.push_back(std::move(right_));
+        }
+
         ExpressionNode& left()
         {
             return *left_;
@@ -101,17 +151,17 @@ namespace AST
 
     namespace helpers
     {
-        AddNodePtr add(ExpressionNodePtr left, ExpressionNodePtr right)
+        inline AddNodePtr add(ExpressionNodePtr left, ExpressionNodePtr right)
         {
             return std::make_unique<AddNode>(std::move(left), std::move(right));
         }
 
-        ExpressionNodePtr integer(int value)
+        inline ExpressionNodePtr integer(int value)
         {
             return std::make_unique<IntNode>(value);
         }
 
-        MultiplyNodePtr multiply(ExpressionNodePtr left, ExpressionNodePtr right)
+        inline MultiplyNodePtr multiply(ExpressionNodePtr left, ExpressionNodePtr right)
         {
             return std::make_unique<MultiplyNode>(std::move(left), std::move(right));
         }
@@ -0,0 +1,252 @@
+#ifndef AST_VARIANT_HPP
+#define AST_VARIANT_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Closed hierarchy of expression nodes - alternative to the open AST::ExpressionNode hierarchy.
+// Nodes are stored by value in a NodePool and refer to their children by index,
+// visitors are dispatched with std::visit instead of virtual accept/visit calls.
+namespace AST::Variant
+{
+    using NodeId = std::uint32_t;
+
+    struct IntNode
+    {
+        int value;
+    };
+
+    struct AddNode
+    {
+        NodeId left;
+        NodeId right;
+    };
+
+    struct MultiplyNode
+    {
+        NodeId left;
+        NodeId right;
+    };
+
+    using Node = std::variant<IntNode, AddNode, MultiplyNode>;
+
+    class NodePool
+    {
+        std::vector<Node> nodes_;
+
+    public:
+        NodeId integer(int value)
+        {
+            return push(IntNode{value});
+        }
+
+        NodeId add(NodeId left, NodeId right)
+        {
+            return push(AddNode{left, right});
+        }
+
+        NodeId multiply(NodeId left, NodeId right)
+        {
+            return push(MultiplyNode{left, right});
+        }
+
+        Node& operator[](NodeId id)
+        {
+            return nodes_[id];
+        }
+
+        const Node& operator[](NodeId id) const
+        {
+            return nodes_[id];
+        }
+
+        std::size_t size() const
+        {
+            return nodes_.size();
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            nodes_.reserve(capacity);
+        }
+
+        void clear()
+        {
+            nodes_.clear();
+        }
+
+    private:
+        template <typename TNode>
+        NodeId push(const TNode& node)
+        {
+            nodes_.emplace_back(std::in_place_type<TNode>, node);
+            return static_cast<NodeId>(nodes_.size() - 1);
+        }
+    };
+
+    // Evaluates in post-order: walks down the left spine and keeps the binary nodes waiting for
+    // their right operand, with the value of the left one, on an explicit stack - the depth of
+    // the tree is not limited by the call stack. No dispatch per stack entry, so it stays close
+    // to the speed of the recursive version.
+    class ExprEvalVisitor
+    {
+        // binary node whose left operand is being evaluated, then its right one
+        struct Frame
+        {
+            NodeId right;
+            bool is_multiply;
+            bool right_pending;
+            int left_value;
+        };
+
+        const NodePool& pool_;
+        std::vector<Frame> frames_;
+
+    public:
+        explicit ExprEvalVisitor(const NodePool& pool) : pool_{pool}
+        {
+        }
+
+        int evaluate(NodeId root)
+        {
+            NodeId id = root;
+
+            while (true)
+            {
+                // down the left spine to a leaf
+                const Node* node = &pool_[id];
+                while (!std::holds_alternative<IntNode>(*node))
+                {
+                    const bool is_multiply = std::holds_alternative<MultiplyNode>(*node);
+                    const NodeId left = is_multiply ? std::get<MultiplyNode>(*node).left : std::get<AddNode>(*node).left;
+                    const NodeId right = is_multiply ? std::get<MultiplyNode>(*node).right : std::get<AddNode>(*node).right;
+                    frames_.push_back(Frame{right, is_multiply, true, 0});
+                    node = &pool_[left];
+                }
+
+                int value = std::get<IntNode>(*node).value;
+
+                // up while right operands are done
+                while (!frames_.empty() && !frames_.back().right_pending)
+                {
+                    const Frame& frame = frames_.back();
+                    value = frame.is_multiply ? frame.left_value * value : frame.left_value + value;
+                    frames_.pop_back();
+                }
+
+                if (frames_.empty())
+                    return value;
+
+                Frame& frame = frames_.back();
+                frame.left_value = value;
+                frame.right_pending = false;
+                id = frame.right;
+            }
+        }
+    };
+
+    // Prints with the minimal number of parentheses - same rules as the classic ::PrintingVisitor.
+    // Walks down the left spine and keeps the binary nodes waiting for their right operand on an
+    // explicit stack, so the depth of the tree is not limited by the call stack. The stack takes
+    // 8 bytes per level of the tree (O(depth) beyond the output); it is kept between calls of
+    // print(), so a reused visitor allocates it once for the deepest expression.
+    class PrintingVisitor
+    {
+        enum Precedence
+        {
+            lowest,
+            addition,
+            multiplication
+        };
+
+        struct Frame
+        {
+            NodeId right;
+            bool is_multiply;
+            bool parenthesized;
+            bool right_pending;
+        };
+
+        const NodePool& pool_;
+        std::string& out_;
+        std::vector<Frame> frames_;
+
+    public:
+        PrintingVisitor(const NodePool& pool, std::string& out)
+            : pool_{pool}, out_{out}
+        {
+        }
+
+        void print(NodeId root)
+        {
+            NodeId id = root;
+            Precedence parent_precedence = lowest;
+
+            while (true)
+            {
+                // down the left spine to a leaf
+                const Node* node = &pool_[id];
+                while (!std::holds_alternative<IntNode>(*node))
+                {
+                    const bool is_multiply = std::holds_alternative<MultiplyNode>(*node);
+                    const NodeId left = is_multiply ? std::get<MultiplyNode>(*node).left : std::get<AddNode>(*node).left;
+                    const NodeId right = is_multiply ? std::get<MultiplyNode>(*node).right : std::get<AddNode>(*node).right;
+                    const Precedence precedence = is_multiply ? multiplication : addition;
+
+                    const bool parenthesized = precedence < parent_precedence;
+                    if (parenthesized)
+                        out_ += '(';
+
+                    frames_.push_back(Frame{right, is_multiply, parenthesized, true});
+                    parent_precedence = precedence;
+                    node = &pool_[left];
+                }
+
+                char digits[16];
+                auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), std::get<IntNode>(*node).value);
+                out_.append(digits, end);
+
+                // up to the first node whose right operand is still to print
+                while (!frames_.empty() && !frames_.back().right_pending)
+                {
+                    if (frames_.back().parenthesized)
+                        out_ += ')';
+                    frames_.pop_back();
+                }
+
+                if (frames_.empty())
+                    return;
+
+                Frame& frame = frames_.back();
+                out_ += frame.is_multiply ? " * " : " + ";
+                frame.right_pending = false;
+                parent_precedence = frame.is_multiply ? multiplication : addition;
+                id = frame.right;
+            }
+        }
+    };
+
+    inline int evaluate(const NodePool& pool, NodeId root)
+    {
+        return ExprEvalVisitor{pool}.evaluate(root);
+    }
+
+    // Appends the expression to out
+    inline void print(const NodePool& pool, NodeId root, std::string& out)
+    {
+        PrintingVisitor{pool, out}.print(root);
+    }
+
+    inline std::string to_string(const NodePool& pool, NodeId root)
+    {
+        std::string out;
+        print(pool, root, out);
+        return out;
+    }
+}
+
+#endif // AST_VARIANT_HPP
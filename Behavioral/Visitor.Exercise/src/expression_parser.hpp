@@ -0,0 +1,322 @@
+#ifndef EXPRESSION_PARSER_HPP
+#define EXPRESSION_PARSER_HPP
+
+#include "ast.hpp"
+#include "ast_variant.hpp"
+
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Infix parser for expressions built of integers, '+', '*' and parentheses, e.g. "3 + 2 * (5 + 1)".
+// Nodes are created through a builder, so the same parser fills a Variant::NodePool (arena)
+// or builds a classic AST::ExpressionNode tree.
+namespace AST::Parsing
+{
+    class ParseError : public std::runtime_error
+    {
+        std::string reason_;
+        std::size_t column_;
+        std::size_t line_;
+
+    public:
+        ParseError(const std::string& reason, std::size_t column, std::size_t line = 0)
+            : std::runtime_error{format(reason, column, line)}, reason_{reason}, column_{column}, line_{line}
+        {
+        }
+
+        const std::string& reason() const
+        {
+            return reason_;
+        }
+
+        // 1-based position of the offending character
+        std::size_t column() const
+        {
+            return column_;
+        }
+
+        // 1-based line number - 0 when a single expression was parsed
+        std::size_t line() const
+        {
+            return line_;
+        }
+
+    private:
+        static std::string format(const std::string& reason, std::size_t column, std::size_t line)
+        {
+            std::string result = reason + " at column " + std::to_string(column);
+            if (line != 0)
+                result += " of line " + std::to_string(line);
+            return result;
+        }
+    };
+
+    // Builds nodes in a NodePool - no allocations except amortized growth of the pool
+    class PoolBuilder
+    {
+        Variant::NodePool& pool_;
+
+    public:
+        using NodeRef = Variant::NodeId;
+
+        explicit PoolBuilder(Variant::NodePool& pool) : pool_{pool}
+        {
+        }
+
+        NodeRef integer(int value)
+        {
+            return pool_.integer(value);
+        }
+
+        NodeRef add(NodeRef left, NodeRef right)
+        {
+            return pool_.add(left, right);
+        }
+
+        NodeRef multiply(NodeRef left, NodeRef right)
+        {
+            return pool_.multiply(left, right);
+        }
+    };
+
+    // Builds a classic tree of AST::ExpressionNode objects
+    class TreeBuilder
+    {
+    public:
+        using NodeRef = ExpressionNodePtr;
+
+        NodeRef integer(int value)
+        {
+            return helpers::integer(value);
+        }
+
+        NodeRef add(NodeRef left, NodeRef right)
+        {
+            return helpers::add(std::move(left), std::move(right));
+        }
+
+        NodeRef multiply(NodeRef left, NodeRef right)
+        {
+            return helpers::multiply(std::move(left), std::move(right));
+        }
+    };
+
+    // Operator precedence parser with explicit stacks - nesting depth is not limited by the call stack.
+    // The stacks are reused between calls, so after warm-up parsing does not allocate.
+    template <typename TBuilder>
+    class ExpressionParser
+    {
+    public:
+        using NodeRef = typename TBuilder::NodeRef;
+
+    private:
+        TBuilder& builder_;
+        std::vector<NodeRef> operands_;
+        std::vector<char> operators_;
+
+    public:
+        explicit ExpressionParser(TBuilder& builder) : builder_{builder}
+        {
+        }
+
+        NodeRef parse(std::string_view text)
+        {
+            operands_.clear();
+            operators_.clear();
+
+            bool expect_operand = true;
+            std::size_t pos = 0;
+
+            while (pos < text.size())
+            {
+                const char c = text[pos];
+
+                if (c == ' ' || c == '\t' || c == '\r')
+                {
+                    ++pos;
+                    continue;
+                }
+
+                if (expect_operand)
+                {
+                    if (is_digit(c) || c == '-')
+                    {
+                        operands_.push_back(builder_.integer(parse_integer(text, pos)));
+                        expect_operand = false;
+                    }
+                    else if (c == '(')
+                    {
+                        operators_.push_back(c);
+                        ++pos;
+                    }
+                    else
+                    {
+                        throw ParseError{std::string{"Unexpected character '"} + c + "'", pos + 1};
+                    }
+                }
+                else
+                {
+                    switch (c)
+                    {
+                    case '+':
+                    case '*':
+                        while (!operators_.empty() && operators_.back() != '(' && precedence(operators_.back()) >= precedence(c))
+                            reduce();
+
+                        operators_.push_back(c);
+                        expect_operand = true;
+                        break;
+                    case ')':
+                        while (!operators_.empty() && operators_.back() != '(')
+                            reduce();
+
+                        if (operators_.empty())
+                            throw ParseError{"Unmatched ')'", pos + 1};
+
+                        operators_.pop_back();
+                        break;
+                    default:
+                        throw ParseError{std::string{"Unexpected character '"} + c + "'", pos + 1};
+                    }
+                    ++pos;
+                }
+            }
+
+            if (expect_operand)
+                throw ParseError{"Unexpected end of expression", pos + 1};
+
+            while (!operators_.empty())
+            {
+                if (operators_.back() == '(')
+                    throw ParseError{"Missing ')'", pos + 1};
+                reduce();
+            }
+
+            NodeRef root = std::move(operands_.back());
+            operands_.pop_back();
+            return root;
+        }
+
+    private:
+        static bool is_digit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        static int precedence(char op)
+        {
+            return op == '*' ? 2 : 1;
+        }
+
+        static int parse_integer(std::string_view text, std::size_t& pos)
+        {
+            const std::size_t start = pos;
+            const bool negative = text[pos] == '-';
+            if (negative)
+                ++pos;
+
+            if (pos == text.size() || !is_digit(text[pos]))
+                throw ParseError{"Expected digit", pos + 1};
+
+            // at most 10 digits fit in int - checking the range once after the loop is enough
+            const std::size_t digits_start = pos;
+            long long value = 0;
+            for (; pos < text.size() && is_digit(text[pos]); ++pos)
+            {
+                if (pos - digits_start == 10)
+                    throw ParseError{"Integer out of range", start + 1};
+                value = value * 10 + (text[pos] - '0');
+            }
+
+            const long long limit = negative ? -static_cast<long long>(std::numeric_limits<int>::min()) : std::numeric_limits<int>::max();
+            if (value > limit)
+                throw ParseError{"Integer out of range", start + 1};
+
+            return static_cast<int>(negative ? -value : value);
+        }
+
+        void reduce()
+        {
+            const char op = operators_.back();
+            operators_.pop_back();
+
+            NodeRef right = std::move(operands_.back());
+            operands_.pop_back();
+            NodeRef left = std::move(operands_.back());
+            operands_.pop_back();
+
+            if (op == '+')
+                operands_.push_back(builder_.add(std::move(left), std::move(right)));
+            else
+                operands_.push_back(builder_.multiply(std::move(left), std::move(right)));
+        }
+    };
+
+    // Reads one expression per line from a stream in fixed-size chunks and passes each parsed root
+    // to on_expression(root, line_number). Empty lines and lines starting with '#' are skipped.
+    // The chunk buffer grows only when a single line does not fit in it.
+    // Returns the number of parsed expressions.
+    template <typename TBuilder, typename TCallback>
+    std::size_t parse_lines(std::istream& in, ExpressionParser<TBuilder>& parser, TCallback&& on_expression, std::size_t chunk_size = 1 << 20)
+    {
+        std::vector<char> buffer(chunk_size > 0 ? chunk_size : 1);
+        std::size_t filled = 0;
+        std::size_t line_number = 0;
+        std::size_t count = 0;
+
+        auto process_line = [&](std::string_view line) {
+            ++line_number;
+
+            const auto first = line.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos || line[first] == '#')
+                return;
+
+            try
+            {
+                on_expression(parser.parse(line), line_number);
+            }
+            catch (const ParseError& e)
+            {
+                throw ParseError{e.reason(), e.column(), line_number};
+            }
+            ++count;
+        };
+
+        while (true)
+        {
+            in.read(buffer.data() + filled, static_cast<std::streamsize>(buffer.size() - filled));
+            filled += static_cast<std::size_t>(in.gcount());
+            const bool at_end = !in;
+
+            std::size_t line_start = 0;
+            while (const void* newline = std::memchr(buffer.data() + line_start, '\n', filled - line_start))
+            {
+                const auto line_end = static_cast<std::size_t>(static_cast<const char*>(newline) - buffer.data());
+                process_line(std::string_view{buffer.data() + line_start, line_end - line_start});
+                line_start = line_end + 1;
+            }
+
+            if (at_end)
+            {
+                if (line_start < filled)
+                    process_line(std::string_view{buffer.data() + line_start, filled - line_start});
+                break;
+            }
+
+            std::memmove(buffer.data(), buffer.data() + line_start, filled - line_start);
+            filled -= line_start;
+
+            if (filled == buffer.size())
+                buffer.resize(buffer.size() * 2);
+        }
+
+        return count;
+    }
+}
+
+#endif // EXPRESSION_PARSER_HPP
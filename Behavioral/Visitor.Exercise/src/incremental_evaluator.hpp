@@ -0,0 +1,168 @@
+#ifndef INCREMENTAL_EVALUATOR_HPP
+#define INCREMENTAL_EVALUATOR_HPP
+
+#include "ast_variant.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace AST::Variant
+{
+    // Keeps the value of every node in a pool. Changing an IntNode with set_value() marks only its
+    // ancestors as dirty (stopping at nodes that are already dirty) and the next value() call
+    // recomputes just those nodes - O(depth) work after a local edit instead of O(size).
+    // Subtrees shared by several parents (e.g. after CSE) are evaluated once.
+    //
+    // A node can refer only to nodes created before it, so recomputing dirty nodes in increasing
+    // id order always sees up-to-date children and needs no recursion.
+    class IncrementalEvaluator
+    {
+        NodePool& pool_;
+        std::vector<int> values_;
+        std::vector<std::uint8_t> dirty_;
+        std::vector<NodeId> pending_;
+
+        // parents of node i: parents_[parent_offsets_[i] .. parent_offsets_[i + 1])
+        std::vector<std::size_t> parent_offsets_;
+        std::vector<NodeId> parents_;
+
+        std::size_t last_recomputed_count_{};
+
+    public:
+        explicit IncrementalEvaluator(NodePool& pool) : pool_{pool}
+        {
+            rebuild();
+        }
+
+        int value(NodeId id)
+        {
+            if (values_.size() != pool_.size())
+                rebuild();
+            else
+                refresh();
+
+            return values_[id];
+        }
+
+        void set_value(NodeId id, int value)
+        {
+            if (values_.size() != pool_.size())
+                rebuild();
+
+            auto* int_node = std::get_if<IntNode>(&pool_[id]);
+            if (!int_node)
+                throw std::invalid_argument("Only the value of IntNode can be changed");
+
+            if (int_node->value == value)
+                return;
+
+            int_node->value = value;
+            values_[id] = value;
+            mark_ancestors_dirty(id);
+        }
+
+        // Number of nodes recomputed by the last evaluation
+        std::size_t last_recomputed_count() const
+        {
+            return last_recomputed_count_;
+        }
+
+    private:
+        void rebuild()
+        {
+            const std::size_t size = pool_.size();
+
+            parent_offsets_.assign(size + 1, 0);
+            for (NodeId id = 0; id < size; ++id)
+                for_each_child(id, [this](NodeId child) { ++parent_offsets_[child + 1]; });
+
+            for (std::size_t i = 1; i <= size; ++i)
+                parent_offsets_[i] += parent_offsets_[i - 1];
+
+            parents_.resize(parent_offsets_[size]);
+            std::vector<std::size_t> next_slot(parent_offsets_.begin(), parent_offsets_.end() - 1);
+            for (NodeId id = 0; id < size; ++id)
+                for_each_child(id, [&](NodeId child) { parents_[next_slot[child]++] = id; });
+
+            values_.resize(size);
+            dirty_.assign(size, 0);
+            pending_.clear();
+
+            for (NodeId id = 0; id < size; ++id)
+                values_[id] = compute(id);
+
+            last_recomputed_count_ = size;
+        }
+
+        void refresh()
+        {
+            std::sort(pending_.begin(), pending_.end());
+
+            for (NodeId id : pending_)
+            {
+                values_[id] = compute(id);
+                dirty_[id] = 0;
+            }
+
+            last_recomputed_count_ = pending_.size();
+            pending_.clear();
+        }
+
+        void mark_ancestors_dirty(NodeId id)
+        {
+            // pending_ doubles as the work list - every newly dirty node is visited exactly once
+            std::size_t next = pending_.size();
+            push_dirty_parents(id);
+
+            while (next < pending_.size())
+                push_dirty_parents(pending_[next++]);
+        }
+
+        void push_dirty_parents(NodeId id)
+        {
+            for (std::size_t i = parent_offsets_[id]; i < parent_offsets_[id + 1]; ++i)
+            {
+                const NodeId parent = parents_[i];
+                if (!dirty_[parent])
+                {
+                    dirty_[parent] = 1;
+                    pending_.push_back(parent);
+                }
+            }
+        }
+
+        int compute(NodeId id) const
+        {
+            const Node& node = pool_[id];
+
+            if (auto* add = std::get_if<AddNode>(&node))
+                return values_[add->left] + values_[add->right];
+
+            if (auto* multiply = std::get_if<MultiplyNode>(&node))
+                return values_[multiply->left] * values_[multiply->right];
+
+            return std::get<IntNode>(node).value;
+        }
+
+        template <typename TFunction>
+        void for_each_child(NodeId id, TFunction f) const
+        {
+            const Node& node = pool_[id];
+
+            if (auto* add = std::get_if<AddNode>(&node))
+            {
+                f(add->left);
+                f(add->right);
+            }
+            else if (auto* multiply = std::get_if<MultiplyNode>(&node))
+            {
+                f(multiply->left);
+                f(multiply->right);
+            }
+        }
+    };
+}
+
+#endif // INCREMENTAL_EVALUATOR_HPP
@@ -1,43 +1,345 @@
 #ifndef VISITORS_HPP
 #define VISITORS_HPP
 
+#include "arithmetic.hpp"
 #include "ast.hpp"
 
-class ExprEvalVisitor : public AST::AstVisitor
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Prints an expression with the minimal number of parentheses straight into an output buffer.
+// Both operators are associative, so only an addition nested in a multiplication needs parentheses.
+// The buffer can be supplied by the caller and reused between expressions. With max_length
+// the printer stops once an expression reaches that many characters - the last token may
+// exceed it, truncated() tells if something was left out.
+//
+// Degenerate trees (e.g. a long sum parsed into a left-deep chain) may be millions of levels
+// deep, so the printer walks down the left spine and keeps the binary nodes waiting for their
+// right operand on an explicit stack instead of the call stack. The stack takes 16 bytes per
+// level of the tree (O(depth) beyond the output); it is kept between expressions, so a reused
+// printer allocates it once for the deepest one.
+class PrintingVisitor : public AST::AstVisitor
 {
-    int result_{};
+    enum Precedence
+    {
+        lowest,
+        addition,
+        multiplication
+    };
+
+    struct Frame
+    {
+        AST::ExpressionNode* right;
+        bool is_multiply;
+        bool parenthesized;
+        bool right_pending;
+    };
+
+    std::string own_buffer_;
+    std::string& out_;
+    std::vector<Frame> frames_;
+    AST::ExpressionNode* next_ = nullptr; // left operand of the binary node just visited
+    Precedence parent_precedence_ = lowest;
+    bool printing_ = false;
+    std::size_t max_length_;
+    bool truncated_ = false;
 
 public:
+    explicit PrintingVisitor(std::size_t max_length = std::string::npos) : out_{own_buffer_}, max_length_{max_length}
+    {
+    }
+
+    explicit PrintingVisitor(std::string& out, std::size_t max_length = std::string::npos) : out_{out}, max_length_{max_length}
+    {
+    }
+
+    PrintingVisitor(const PrintingVisitor&) = delete;
+    PrintingVisitor& operator=(const PrintingVisitor&) = delete;
+
     void visit(AST::AddNode& node)
     {
-        ExprEvalVisitor lv, rv;
-        node.left().accept(lv);
-        node.right().accept(rv);
-        result_ = lv.result() + rv.result();
+        visit_binary(node.left(), node.right(), false);
     }
 
     void visit(AST::MultiplyNode& node)
     {
-        ExprEvalVisitor lv, rv;
-        node.left().accept(lv);
-        node.right().accept(rv);
-        result_ = lv.result() * rv.result();
+        visit_binary(node.left(), node.right(), true);
     }
 
     void visit(AST::IntNode& node)
     {
-        result_ = node.value();
+        char digits[16];
+        auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), node.value());
+        out_.append(digits, end);
     }
 
-    int result() const
+    const std::string& str() const
     {
-        return result_;
+        return out_;
+    }
+
+    void clear()
+    {
+        out_.clear();
+        truncated_ = false;
+    }
+
+    bool truncated() const
+    {
+        return truncated_;
+    }
+
+private:
+    // The outermost call prints the whole expression, nested ones only step down the left spine
+    void visit_binary(AST::ExpressionNode& left, AST::ExpressionNode& right, bool is_multiply)
+    {
+        const Precedence precedence = is_multiply ? multiplication : addition;
+        const bool parenthesized = precedence < parent_precedence_;
+        if (parenthesized)
+            out_ += '(';
+
+        frames_.push_back(Frame{&right, is_multiply, parenthesized, true});
+        parent_precedence_ = precedence;
+        next_ = &left;
+
+        if (!printing_)
+            print_frames();
+    }
+
+    void print_frames()
+    {
+        const std::size_t end_length = max_length_ < std::string::npos - out_.size() ? out_.size() + max_length_ : std::string::npos;
+        printing_ = true;
+
+        try
+        {
+            AST::ExpressionNode* node = next_;
+
+            while (true)
+            {
+                // down the left spine - a leaf leaves next_ empty
+                while (node && out_.size() < end_length)
+                {
+                    next_ = nullptr;
+                    node->accept(*this);
+                    node = next_;
+                }
+
+                // up to the first node whose right operand is still to print
+                while (!node && !frames_.empty() && !frames_.back().right_pending && out_.size() < end_length)
+                {
+                    if (frames_.back().parenthesized)
+                        out_ += ')';
+                    frames_.pop_back();
+                }
+
+                if (!node && frames_.empty())
+                    break;
+
+                if (out_.size() >= end_length)
+                {
+                    frames_.clear();
+                    truncated_ = true;
+                    break;
+                }
+
+                Frame& frame = frames_.back();
+                out_ += frame.is_multiply ? " * " : " + ";
+                frame.right_pending = false;
+                parent_precedence_ = frame.is_multiply ? multiplication : addition;
+                node = frame.right;
+            }
+        }
+        catch (...)
+        {
+            frames_.clear();
+            printing_ = false;
+            parent_precedence_ = lowest;
+            throw;
+        }
+
+        printing_ = false;
+        parent_precedence_ = lowest;
     }
 };
 
-// TODO
-class PrintingVisitor
+// Integer overflow detected by an evaluator using Arithmetic::Checked
+class OverflowError : public std::overflow_error
 {
+    AST::ExpressionNode* node_;
+
+public:
+    OverflowError(const std::string& message, AST::ExpressionNode& node) : std::overflow_error{message}, node_{&node}
+    {
+    }
+
+    // Node whose operation overflowed
+    AST::ExpressionNode& node() const
+    {
+        return *node_;
+    }
+};
+
+// Evaluates an expression using TValue and the arithmetic policy chosen at compile time.
+// Parsed long sums are trees millions of levels deep, so evaluation runs in post-order without
+// recursion: it walks down the left spine and keeps the binary nodes waiting for their right
+// operand, with the value of the left one, on an explicit stack.
+template <typename TValue, typename TArithmetic = Arithmetic::Unchecked>
+class BasicExprEvalVisitor : public AST::AstVisitor
+{
+    enum class Operation
+    {
+        add,
+        multiply
+    };
+
+    struct Frame
+    {
+        AST::ExpressionNode* node;
+        AST::ExpressionNode* right;
+        Operation operation;
+        bool right_pending;
+        TValue left_value;
+    };
+
+    TValue result_{};
+    std::vector<Frame> frames_;
+    AST::ExpressionNode* next_ = nullptr; // left operand of the binary node just visited
+    bool evaluating_ = false;
+
+public:
+    void visit(AST::AddNode& node)
+    {
+        visit_binary(node, node.left(), node.right(), Operation::add);
+    }
+
+    void visit(AST::MultiplyNode& node)
+    {
+        visit_binary(node, node.left(), node.right(), Operation::multiply);
+    }
+
+    void visit(AST::IntNode& node)
+    {
+        result_ = static_cast<TValue>(node.value());
+    }
+
+    TValue result() const
+    {
+        return result_;
+    }
+
+private:
+    void visit_binary(AST::ExpressionNode& node, AST::ExpressionNode& left, AST::ExpressionNode& right, Operation operation)
+    {
+        frames_.push_back(Frame{&node, &right, operation, true, TValue{}});
+        next_ = &left;
+
+        if (!evaluating_)
+            evaluate_frames();
+    }
+
+    void evaluate_frames()
+    {
+        evaluating_ = true;
+
+        try
+        {
+            AST::ExpressionNode* node = next_;
+
+            while (true)
+            {
+                // down the left spine - a leaf leaves next_ empty
+                while (node)
+                {
+                    next_ = nullptr;
+                    node->accept(*this);
+                    node = next_;
+                }
+
+                TValue value = result_;
+
+                // up while right operands are done
+                while (!frames_.empty() && !frames_.back().right_pending)
+                {
+                    const Frame& frame = frames_.back();
+                    const TValue left = frame.left_value;
+                    const TValue right = value;
+
+                    if (frame.operation == Operation::add ? TArithmetic::add(left, right, value) : TArithmetic::multiply(left, right, value))
+                        throw_overflow(*frame.node, left, frame.operation == Operation::add ? " + " : " * ", right);
+
+                    frames_.pop_back();
+                }
+
+                if (frames_.empty())
+                {
+                    result_ = value;
+                    break;
+                }
+
+                Frame& frame = frames_.back();
+                frame.left_value = value;
+                frame.right_pending = false;
+                node = frame.right;
+            }
+        }
+        catch (...)
+        {
+            frames_.clear();
+            evaluating_ = false;
+            throw;
+        }
+
+        evaluating_ = false;
+    }
+
+private:
+    [[noreturn]] static void throw_overflow(AST::ExpressionNode& node, TValue left, const char* op, TValue right)
+    {
+        const std::size_t max_expression_length = 80;
+
+        // the overflowing subtree may have millions of nodes - only its beginning is printed
+        PrintingVisitor printer{max_expression_length};
+        node.accept(printer);
+        std::string expression = printer.str().substr(0, max_expression_length);
+        if (printer.truncated() || printer.str().size() > max_expression_length)
+            expression += "...";
+
+        throw OverflowError{"Integer overflow in " + format_value(left) + op + format_value(right) + " evaluating: " + expression, node};
+    }
+
+    // std::to_string has no overload for __int128
+    static std::string format_value(TValue value)
+    {
+        char digits[48];
+        char* const end = std::end(digits);
+        char* first = end;
+        const bool negative = value < 0;
+
+        do
+        {
+            const auto digit = static_cast<int>(value % 10);
+            *--first = static_cast<char>('0' + (negative ? -digit : digit));
+            value /= 10;
+        } while (value != 0);
+
+        if (negative)
+            *--first = '-';
+
+        return std::string(first, end);
+    }
 };
 
+using ExprEvalVisitor = BasicExprEvalVisitor<int>;
+using Int64EvalVisitor = BasicExprEvalVisitor<std::int64_t>;
+using CheckedEvalVisitor = BasicExprEvalVisitor<std::int64_t, Arithmetic::Checked>;
+
+#ifdef __SIZEOF_INT128__
+using Int128EvalVisitor = BasicExprEvalVisitor<__int128>;
+#endif
+
 #endif // VISITORS_HPP
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "visitors.hpp"
 #include <catch2/catch_test_macros.hpp>
 
+#include <string>
+
 using namespace AST;
 using namespace AST::helpers;
 
@@ -43,42 +45,194 @@ TEST_CASE("expression evaluator visitor", "[ast]")
     }
 }
 
+TEST_CASE("evaluation modes", "[ast]")
+{
+    // 100000 * 100000 * 100000 does not fit in int - one more multiplication by 10^10 overflows int64
+    auto big = multiply(multiply(integer(100'000), integer(100'000)), integer(100'000));
+
+    SECTION("int64")
+    {
+        Int64EvalVisitor visitor;
+        big->accept(visitor);
+
+        REQUIRE(visitor.result() == 1'000'000'000'000'000LL);
+    }
+
+    SECTION("checked - result in range")
+    {
+        CheckedEvalVisitor visitor;
+        big->accept(visitor);
+
+        REQUIRE(visitor.result() == 1'000'000'000'000'000LL);
+    }
+
+    SECTION("checked - overflow reports the node")
+    {
+        auto overflowing = multiply(std::move(big), multiply(integer(100'000), integer(100'000)));
+        auto& overflowing_node = *overflowing;
+        auto expr = add(integer(1), std::move(overflowing));
+
+        CheckedEvalVisitor visitor;
+
+        try
+        {
+            expr->accept(visitor);
+            FAIL("OverflowError expected");
+        }
+        catch (const OverflowError& e)
+        {
+            REQUIRE(&e.node() == &overflowing_node);
+            REQUIRE(std::string{e.what()}.find("1000000000000000 * 10000000000") != std::string::npos);
+        }
+    }
+
+#ifdef __SIZEOF_INT128__
+    SECTION("int128")
+    {
+        auto huge = multiply(std::move(big), multiply(integer(100'000), integer(100'000)));
+
+        Int128EvalVisitor visitor;
+        huge->accept(visitor);
+
+        REQUIRE(visitor.result() == static_cast<__int128>(1'000'000'000'000'000LL) * 10'000'000'000LL);
+    }
+#endif
+}
+
+TEST_CASE("overflow report")
+{
+    SECTION("only the beginning of a large subtree is printed")
+    {
+        ExpressionNodePtr sum = integer(1'000'000'000);
+        for (int i = 0; i < 1'000'000; ++i)
+            sum = add(std::move(sum), integer(1'000'000'000));
+        auto expr = multiply(std::move(sum), integer(1'000'000'000));
+
+        CheckedEvalVisitor visitor;
+
+        try
+        {
+            expr->accept(visitor);
+            FAIL("OverflowError expected");
+        }
+        catch (const OverflowError& e)
+        {
+            const std::string message = e.what();
+            const std::string expected = "Integer overflow in 1000001000000000 * 1000000000 evaluating: (1000000000 + 1000000000 + ";
+            REQUIRE(message.compare(0, expected.size(), expected) == 0);
+            REQUIRE(message.size() < 200);
+            REQUIRE(message.compare(message.size() - 3, 3, "...") == 0);
+        }
+    }
+
+#ifdef __SIZEOF_INT128__
+    SECTION("int128 operands are printed in full")
+    {
+        ExpressionNodePtr product = integer(100'000);
+        for (int i = 0; i < 7; ++i)
+            product = multiply(std::move(product), integer(100'000));
+
+        BasicExprEvalVisitor<__int128, Arithmetic::Checked> visitor;
+
+        try
+        {
+            product->accept(visitor);
+            FAIL("OverflowError expected");
+        }
+        catch (const OverflowError& e)
+        {
+            REQUIRE(std::string{e.what()}.find("Integer overflow in 100000000000000000000000000000000000 * 100000 evaluating") == 0);
+        }
+    }
+#endif
+}
+
 TEST_CASE("printing visitor")
 {
-    // TODO - uncomment tests
+    PrintingVisitor visitor;
+
+    SECTION("integer")
+    {
+        auto expr = integer(4);
+        expr->accept(visitor);
+
+        REQUIRE(visitor.str() == "4");
+    }
 
-    // PrintingVisitor visitor;
+    SECTION("addition")
+    {
+        auto expr = add(integer(1), integer(2));
+        expr->accept(visitor);
 
-    // SECTION("integer")
-    // {
-    //     auto expr = integer(4);
-    //     expr->accept(visitor);
+        REQUIRE(visitor.str() == "1 + 2");
+    }
+
+    SECTION("multiplication")
+    {
+        auto expr = multiply(integer(2), integer(3));
+        expr->accept(visitor);
 
-    //     REQUIRE(visitor.str() == "4");
-    // }
+        REQUIRE(visitor.str() == "2 * 3");
+    }
 
-    // SECTION("addition")
-    // {
-    //     auto expr = add(integer(1), integer(2));
-    //     expr->accept(visitor);
+    SECTION("composite expression")
+    {
+        auto expr = add(integer(3), multiply(integer(2), integer(5)));
 
-    //     REQUIRE(visitor.str() == "(1 + 2)");
-    // }
+        expr->accept(visitor);
 
-    // SECTION("multiplication")
-    // {
-    //     auto expr = multiply(integer(2), integer(3));
-    //     expr->accept(visitor);
+        REQUIRE(visitor.str() == "3 + 2 * 5");
+    }
+    SECTION("parentheses only where precedence requires them")
+    {
+        auto expr = multiply(add(integer(1), integer(2)), add(integer(3), multiply(integer(4), integer(-5))));
 
-    //     REQUIRE(visitor.str() == "(2 * 3)");
-    // }
+        expr->accept(visitor);
+
+        REQUIRE(visitor.str() == "(1 + 2) * (3 + 4 * -5)");
+    }
+
+    SECTION("nested operations of the same kind")
+    {
+        auto expr = add(add(integer(1), integer(2)), add(integer(3), integer(4)));
+
+        expr->accept(visitor);
+
+        REQUIRE(visitor.str() == "1 + 2 + 3 + 4");
+    }
+}
+
+TEST_CASE("printing visitor prints trees millions of levels deep")
+{
+    constexpr int depth = 2'000'000;
+
+    ExpressionNodePtr expr = integer(1);
+    for (int i = 0; i < depth; ++i)
+        expr = i % 2 ? ExpressionNodePtr{add(std::move(expr), integer(1))} : ExpressionNodePtr{multiply(integer(2), std::move(expr))};
+
+    PrintingVisitor visitor;
+    expr->accept(visitor);
+
+    const std::string& text = visitor.str();
+    REQUIRE(text.compare(0, 10, "2 * (2 * (") == 0);
+    REQUIRE(text.compare(text.size() - 10, 10, ") + 1) + 1") == 0);
+}
+
+TEST_CASE("printing visitor writes to reusable buffer")
+{
+    std::string buffer;
 
-    // SECTION("composite expression")
-    // {
-    //     auto expr = add(integer(3), multiply(integer(2), integer(5)));
+    PrintingVisitor first_printer{buffer};
+    auto first_expr = add(integer(1), integer(2));
+    first_expr->accept(first_printer);
+    REQUIRE(buffer == "1 + 2");
 
-    //     expr->accept(visitor);
+    buffer.clear();
+    const auto* data = buffer.data();
 
-    //     REQUIRE(visitor.str() == "(3 + (2 * 5))");
-    // }
+    PrintingVisitor second_printer{buffer};
+    auto second_expr = multiply(integer(3), integer(4));
+    second_expr->accept(second_printer);
+    REQUIRE(buffer == "3 * 4");
+    REQUIRE(buffer.data() == data);
 }
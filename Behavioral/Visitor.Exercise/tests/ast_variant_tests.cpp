@@ -0,0 +1,128 @@
+#include "ast_variant.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+using namespace AST::Variant;
+
+TEST_CASE("variant expression evaluator", "[ast][variant]")
+{
+    NodePool pool;
+
+    SECTION("integer")
+    {
+        auto expr = pool.integer(4);
+
+        REQUIRE(evaluate(pool, expr) == 4);
+    }
+
+    SECTION("addition")
+    {
+        auto expr = pool.add(pool.integer(1), pool.integer(2));
+
+        REQUIRE(evaluate(pool, expr) == 3);
+    }
+
+    SECTION("multiplication")
+    {
+        auto expr = pool.multiply(pool.integer(2), pool.integer(3));
+
+        REQUIRE(evaluate(pool, expr) == 6);
+    }
+
+    SECTION("composite expression")
+    {
+        auto expr = pool.add(pool.integer(3), pool.multiply(pool.integer(2), pool.integer(5)));
+
+        REQUIRE(evaluate(pool, expr) == 13);
+    }
+
+    SECTION("shared subtree")
+    {
+        auto two_times_five = pool.multiply(pool.integer(2), pool.integer(5));
+        auto expr = pool.add(two_times_five, two_times_five);
+
+        REQUIRE(evaluate(pool, expr) == 20);
+    }
+}
+
+TEST_CASE("variant printing visitor", "[ast][variant]")
+{
+    NodePool pool;
+
+    SECTION("integer")
+    {
+        REQUIRE(to_string(pool, pool.integer(4)) == "4");
+    }
+
+    SECTION("composite expression")
+    {
+        auto expr = pool.add(pool.integer(3), pool.multiply(pool.integer(2), pool.integer(5)));
+
+        REQUIRE(to_string(pool, expr) == "3 + 2 * 5");
+    }
+    SECTION("parentheses only where precedence requires them")
+    {
+        auto expr = pool.multiply(pool.add(pool.integer(1), pool.integer(2)), pool.integer(3));
+
+        REQUIRE(to_string(pool, expr) == "(1 + 2) * 3");
+    }
+}
+
+TEST_CASE("variant printing visitor prints trees millions of levels deep", "[ast][variant]")
+{
+    constexpr int depth = 4'000'000;
+
+    NodePool pool;
+    pool.reserve(2 * depth + 1);
+
+    SECTION("left-deep sum")
+    {
+        auto expr = pool.integer(1);
+        for (int i = 0; i < depth; ++i)
+            expr = pool.add(expr, pool.integer(1));
+
+        const std::string text = to_string(pool, expr);
+
+        REQUIRE(text.size() == 4u * depth + 1);
+        REQUIRE(text.compare(0, 9, "1 + 1 + 1") == 0);
+    }
+
+    SECTION("nested parentheses")
+    {
+        auto expr = pool.integer(1);
+        for (int i = 0; i < depth / 2; ++i)
+            expr = pool.multiply(pool.integer(2), pool.add(expr, pool.integer(1)));
+
+        const std::string text = to_string(pool, expr);
+
+        REQUIRE(text.compare(0, 10, "2 * (2 * (") == 0);
+        REQUIRE(text.compare(text.size() - 10, 10, " + 1) + 1)") == 0);
+    }
+}
+
+TEST_CASE("variant expression evaluator evaluates trees millions of levels deep", "[ast][variant]")
+{
+    constexpr int depth = 4'000'000;
+
+    NodePool pool;
+    pool.reserve(2 * depth + 1);
+
+    SECTION("left-deep sum")
+    {
+        auto expr = pool.integer(1);
+        for (int i = 0; i < depth; ++i)
+            expr = pool.add(expr, pool.integer(1));
+
+        REQUIRE(evaluate(pool, expr) == depth + 1);
+    }
+
+    SECTION("right-deep expression")
+    {
+        auto expr = pool.integer(0);
+        for (int i = 0; i < depth; ++i)
+            expr = i % 2 ? pool.add(pool.integer(1), expr) : pool.multiply(pool.integer(1), expr);
+
+        REQUIRE(evaluate(pool, expr) == depth / 2);
+    }
+}
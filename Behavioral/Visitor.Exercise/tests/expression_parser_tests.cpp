@@ -0,0 +1,154 @@
+#include "expression_parser.hpp"
+#include "visitors.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace AST;
+using namespace AST::Parsing;
+
+TEST_CASE("parsing expressions into node pool", "[parser]")
+{
+    Variant::NodePool pool;
+    PoolBuilder builder{pool};
+    ExpressionParser parser{builder};
+
+    SECTION("integer")
+    {
+        REQUIRE(Variant::evaluate(pool, parser.parse("42")) == 42);
+    }
+
+    SECTION("negative integer")
+    {
+        REQUIRE(Variant::evaluate(pool, parser.parse("-7 + 2")) == -5);
+    }
+
+    SECTION("multiplication binds tighter than addition")
+    {
+        REQUIRE(Variant::evaluate(pool, parser.parse("3 + 2 * 5")) == 13);
+        REQUIRE(Variant::evaluate(pool, parser.parse("2 * 5 + 3")) == 13);
+    }
+
+    SECTION("parentheses")
+    {
+        REQUIRE(Variant::evaluate(pool, parser.parse("(3 + 2) * 5")) == 25);
+        REQUIRE(Variant::evaluate(pool, parser.parse(" ( ( 1 ) ) ")) == 1);
+    }
+
+    SECTION("deeply nested expression does not exhaust the stack")
+    {
+        const std::size_t depth = 100'000;
+        std::string text = std::string(depth, '(') + "1" + std::string(depth, ')');
+
+        parser.parse(text);
+
+        REQUIRE(pool.size() == 1);
+    }
+
+    SECTION("syntax errors report position")
+    {
+        auto error_column = [&](const char* text) {
+            try
+            {
+                parser.parse(text);
+            }
+            catch (const ParseError& e)
+            {
+                return e.column();
+            }
+            return std::size_t{0};
+        };
+
+        REQUIRE(error_column("") == 1);
+        REQUIRE(error_column("1 +") == 4);
+        REQUIRE(error_column("1 + * 2") == 5);
+        REQUIRE(error_column("(1 + 2") == 7);
+        REQUIRE(error_column("1 + 2)") == 6);
+        REQUIRE(error_column("1 / 2") == 3);
+        REQUIRE(error_column("99999999999") == 1);
+    }
+}
+
+TEST_CASE("parsing expressions into classic AST", "[parser]")
+{
+    TreeBuilder builder;
+    ExpressionParser parser{builder};
+
+    auto expr = parser.parse("3 + 2 * 5");
+
+    ExprEvalVisitor evaluator;
+    expr->accept(evaluator);
+    REQUIRE(evaluator.result() == 13);
+}
+
+TEST_CASE("evaluating a parsed sum of a million terms", "[parser]")
+{
+    constexpr int term_count = 1'000'000;
+
+    std::string text = "2 * 3";
+    for (int i = 1; i < term_count; ++i)
+        text += i % 2 ? " + 1" : " + 2 * 3";
+
+    TreeBuilder builder;
+    ExpressionParser parser{builder};
+    auto expr = parser.parse(text);
+
+    const std::int64_t expected = term_count / 2 * 7;
+
+    SECTION("int")
+    {
+        ExprEvalVisitor evaluator;
+        expr->accept(evaluator);
+        REQUIRE(evaluator.result() == expected);
+    }
+
+    SECTION("checked")
+    {
+        CheckedEvalVisitor evaluator;
+        expr->accept(evaluator);
+        REQUIRE(evaluator.result() == expected);
+    }
+}
+
+TEST_CASE("parsing stream of expressions", "[parser]")
+{
+    Variant::NodePool pool;
+    PoolBuilder builder{pool};
+    ExpressionParser parser{builder};
+
+    std::istringstream in{"1 + 2\n# comment\n\n2 * (3 + 4)\r\n10 * 10"};
+    std::vector<int> results;
+    std::vector<std::size_t> lines;
+
+    SECTION("lines split across chunks")
+    {
+        auto count = parse_lines(in, parser, [&](Variant::NodeId root, std::size_t line) {
+            results.push_back(Variant::evaluate(pool, root));
+            lines.push_back(line);
+            pool.clear();
+        }, 4);
+
+        REQUIRE(count == 3);
+        REQUIRE(results == std::vector{3, 14, 100});
+        REQUIRE(lines == std::vector<std::size_t>{1, 4, 5});
+    }
+
+    SECTION("error reports line number")
+    {
+        std::istringstream bad_in{"1 + 2\n3 +\n"};
+
+        try
+        {
+            parse_lines(bad_in, parser, [](Variant::NodeId, std::size_t) {});
+            FAIL("ParseError expected");
+        }
+        catch (const ParseError& e)
+        {
+            REQUIRE(e.line() == 2);
+            REQUIRE(e.column() == 4);
+        }
+    }
+}
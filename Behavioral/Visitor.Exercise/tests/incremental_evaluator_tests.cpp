@@ -0,0 +1,101 @@
+#include "incremental_evaluator.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+using namespace AST::Variant;
+
+TEST_CASE("incremental evaluator", "[ast][incremental]")
+{
+    NodePool pool;
+    auto two = pool.integer(2);
+    auto five = pool.integer(5);
+    auto three = pool.integer(3);
+    auto product = pool.multiply(two, five);
+    auto root = pool.add(three, product);
+
+    IncrementalEvaluator evaluator{pool};
+
+    REQUIRE(evaluator.value(root) == 13);
+
+    SECTION("value of unchanged tree is cached")
+    {
+        REQUIRE(evaluator.value(root) == 13);
+        REQUIRE(evaluator.last_recomputed_count() == 0);
+    }
+
+    SECTION("changing a leaf recomputes only its ancestors")
+    {
+        evaluator.set_value(five, 10);
+
+        REQUIRE(evaluator.value(root) == 23);
+        REQUIRE(evaluator.last_recomputed_count() == 2);
+        REQUIRE(evaluate(pool, root) == 23);
+    }
+
+    SECTION("setting the same value does not invalidate the cache")
+    {
+        evaluator.set_value(three, 3);
+
+        REQUIRE(evaluator.value(root) == 13);
+        REQUIRE(evaluator.last_recomputed_count() == 0);
+    }
+
+    SECTION("only IntNode value can be changed")
+    {
+        REQUIRE_THROWS_AS(evaluator.set_value(product, 1), std::invalid_argument);
+    }
+
+    SECTION("nodes added after construction are picked up")
+    {
+        auto bigger = pool.multiply(root, pool.integer(2));
+
+        REQUIRE(evaluator.value(bigger) == 26);
+    }
+}
+
+TEST_CASE("incremental evaluator with shared subtrees", "[ast][incremental]")
+{
+    NodePool pool;
+    auto leaf = pool.integer(1);
+    auto shared = pool.add(leaf, leaf);
+    auto left = pool.multiply(shared, pool.integer(3));
+    auto right = pool.multiply(shared, pool.integer(4));
+    auto root = pool.add(left, right);
+
+    IncrementalEvaluator evaluator{pool};
+    REQUIRE(evaluator.value(root) == 14);
+
+    evaluator.set_value(leaf, 2);
+
+    REQUIRE(evaluator.value(root) == 28);
+    REQUIRE(evaluator.last_recomputed_count() == 4);
+}
+
+TEST_CASE("incremental evaluator work after local edit is proportional to depth", "[ast][incremental]")
+{
+    NodePool pool;
+
+    // balanced tree with 2^16 leaves
+    std::vector<NodeId> level;
+    for (int i = 0; i < (1 << 16); ++i)
+        level.push_back(pool.integer(1));
+
+    const NodeId first_leaf = level.front();
+
+    while (level.size() > 1)
+    {
+        std::vector<NodeId> next;
+        for (std::size_t i = 0; i < level.size(); i += 2)
+            next.push_back(pool.add(level[i], level[i + 1]));
+        level = std::move(next);
+    }
+
+    IncrementalEvaluator evaluator{pool};
+    REQUIRE(evaluator.value(level.front()) == (1 << 16));
+
+    evaluator.set_value(first_leaf, 2);
+
+    REQUIRE(evaluator.value(level.front()) == (1 << 16) + 1);
+    REQUIRE(evaluator.last_recomputed_count() == 16);
+}
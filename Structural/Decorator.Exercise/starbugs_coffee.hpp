@@ -2,6 +2,7 @@
 #define COFFEEHELL_HPP_
 
 #include <iostream>
+#include <memory>
 #include <string>
 
 class Coffee